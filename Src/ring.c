@@ -14,28 +14,309 @@
  * @copyright GNU General Public License v3.0
  * @{
  */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#ifdef __unix__
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#endif
+#ifdef RING_DWELL
+#include <time.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RING_X86
+#endif
 #include "ring.h"
 
 /**< Modulo for operations on array indexes. */
 #define MODULO_BUF(value, max) ((value) % (max))
 
+/**< Buffer array was allocated with malloc. */
+#define RING_FLAG_ALLOC		0x01u
+/**< Buffer array is mapped twice, back to back. */
+#define RING_FLAG_MIRRORED	0x02u
+/**< Writes drop the oldest elements instead of returning NO_PLACE. */
+#define RING_FLAG_OVERWRITE	0x04u
+/**< Buffer array was mapped with mmap, mapSize bytes long. */
+#define RING_FLAG_MAPPED	0x08u
+/**< Buffer array is reallocated to grow and shrink with load. */
+#define RING_FLAG_ELASTIC	0x10u
+/**< Reader and writer are notified through eventfds. */
+#define RING_FLAG_EVENTFD	0x20u
+/**< Write time of elements is tracked. */
+#define RING_FLAG_DWELL		0x40u
+/**< Buffer array was allocated with placement options of RingInitAllocEx. */
+#define RING_FLAG_ALIGNED	0x80u
+
+/**< Memory policy of mbind, defined here to not depend on libnuma headers. */
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+
+/**< Checks if size can be used in power-of-two mode. Free-running 32-bit
+ * pointers can describe at most 2^31 elements. */
+static inline int RingIsPow2 (size_t size){
+	return size >= 2 && 0 == (size & (size - 1)) && size <= ((size_t)1 << 31);
+}
+
+/**< Converts write/read pointer to array index given in elements. */
+static inline uint32_t RingIndex (const RingBuffer_t* buffer, uint32_t ptr){
+	return buffer -> mask ? (ptr & buffer -> mask) : ptr;
+}
+
+/**< Moves write/read pointer forward by given count of elements. */
+static inline uint32_t RingAdvance (const RingBuffer_t* buffer, uint32_t ptr, uint32_t cnt){
+	return buffer -> mask ? (ptr + cnt) : MODULO_BUF(ptr + cnt, buffer -> size);
+}
+
+#ifdef RING_STATS
+/**< Adds value to statistics counter. Every counter is written by one side
+ * only, so there is no read-modify-write, store is atomic for scraper only. */
+#define RING_STAT_ADD(buffer, field, value) \
+	__atomic_store_n(&(buffer) -> field, (buffer) -> field + (value), __ATOMIC_RELAXED)
+
+/**< Checks if len elements starting at pointer are split at array end. */
+static inline int RingIsSplit (const RingBuffer_t* buffer, uint32_t ptr, size_t len){
+	return RingIndex(buffer, ptr) + len > buffer -> size && 0 == (buffer -> flags & RING_FLAG_MIRRORED);
+}
+
+/**< Counts len elements written from pointer ptr, after write pointer was moved. */
+static inline void RingStatsWrite (RingBuffer_t* buffer, uint32_t ptr, size_t len){
+	uint32_t used;
+
+	RING_STAT_ADD(buffer, statBytesIn, len * buffer -> elementSize);
+	if(RingIsSplit(buffer, ptr, len)){
+		RING_STAT_ADD(buffer, statWrapWrites, 1);
+	}
+	if(buffer -> mask){
+		used = buffer -> writePtr - __atomic_load_n(&buffer -> readPtr, __ATOMIC_RELAXED);
+	}else{
+		used = buffer -> size - 1 - buffer -> place;
+	}
+	if(used > buffer -> statHighWater){
+		__atomic_store_n(&buffer -> statHighWater, used, __ATOMIC_RELAXED);
+	}
+}
+
+/**< Counts len elements read from pointer ptr. */
+static inline void RingStatsRead (RingBuffer_t* buffer, uint32_t ptr, size_t len){
+	RING_STAT_ADD(buffer, statBytesOut, len * buffer -> elementSize);
+	if(RingIsSplit(buffer, ptr, len)){
+		RING_STAT_ADD(buffer, statWrapReads, 1);
+	}
+}
+#else
+#define RING_STAT_ADD(buffer, field, value) ((void)0)
+
+static inline void RingStatsWrite (RingBuffer_t* buffer, uint32_t ptr, size_t len){
+	(void)buffer;
+	(void)ptr;
+	(void)len;
+}
+
+static inline void RingStatsRead (RingBuffer_t* buffer, uint32_t ptr, size_t len){
+	(void)buffer;
+	(void)ptr;
+	(void)len;
+}
+#endif
+
+#ifdef RING_DWELL
+#ifndef RING_DWELL_NOW
+/**< Monotonic time given in nanoseconds. */
+static inline uint64_t RingDwellNow (void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#define RING_DWELL_NOW() RingDwellNow()
+#endif
+
+/**< Histogram bucket of dwell time: values below 2^RING_DWELL_SUB_BITS have
+ * their own buckets, every higher power of two is split linearly. */
+static inline uint32_t RingDwellBucket (uint64_t value){
+	if(value < (1u << RING_DWELL_SUB_BITS)) return value;
+	uint32_t exp = 63 - __builtin_clzll(value);
+	return ((exp - RING_DWELL_SUB_BITS + 1) << RING_DWELL_SUB_BITS)
+		+ ((value >> (exp - RING_DWELL_SUB_BITS)) & ((1u << RING_DWELL_SUB_BITS) - 1));
+}
+
+/**< The highest dwell time falling into given bucket. */
+static uint64_t RingDwellBucketMax (uint32_t bucket){
+	if(bucket < (1u << RING_DWELL_SUB_BITS)) return bucket;
+	uint32_t shift = (bucket >> RING_DWELL_SUB_BITS) - 1;
+	uint64_t low = (uint64_t)((1u << RING_DWELL_SUB_BITS) | (bucket & ((1u << RING_DWELL_SUB_BITS) - 1))) << shift;
+	return low + (((uint64_t)1 << shift) - 1);
+}
+
+/**< Stamps len slots starting at pointer ptr with current time. Called by
+ * writer before pointer is published. */
+static inline void RingDwellStamp (RingBuffer_t* buffer, uint32_t ptr, size_t len){
+	if(0 == (buffer -> flags & RING_FLAG_DWELL)) return;
+
+	uint64_t now = RING_DWELL_NOW();
+	uint32_t index = RingIndex(buffer, ptr);
+	for(size_t i = 0; i < len; i++){
+		/* Scraper reads stamp of the oldest element concurrently. */
+		__atomic_store_n(&buffer -> dwellStamps[index], now, __ATOMIC_RELAXED);
+		if(++index == buffer -> size){
+			index = 0;
+		}
+	}
+}
+
+/**< Adds dwell times of len slots starting at pointer ptr to histogram.
+ * Called by reader before pointer is moved. Elements of one write share
+ * stamp, so runs of equal stamps are counted at once. */
+static inline void RingDwellSample (RingBuffer_t* buffer, uint32_t ptr, size_t len){
+	if(0 == (buffer -> flags & RING_FLAG_DWELL) || 0 == len) return;
+
+	uint64_t now = RING_DWELL_NOW();
+	uint32_t index = RingIndex(buffer, ptr);
+	uint64_t* hist = buffer -> dwellHist;
+	uint64_t stamp = buffer -> dwellStamps[index];
+	uint64_t run = 0;
+
+	for(size_t i = 0; i <= len; i++){
+		uint64_t next = 0;
+		if(i < len){
+			next = buffer -> dwellStamps[index];
+			if(++index == buffer -> size){
+				index = 0;
+			}
+			if(0 == run || next == stamp){
+				run++;
+				continue;
+			}
+		}
+		uint64_t dwell = (now > stamp) ? (now - stamp) : 0;
+		uint32_t bucket = RingDwellBucket(dwell);
+		/* Counters have single writer, store is atomic for scraper only. */
+		__atomic_store_n(&hist[bucket], hist[bucket] + run, __ATOMIC_RELAXED);
+		if(dwell > buffer -> dwellMax){
+			__atomic_store_n(&buffer -> dwellMax, dwell, __ATOMIC_RELAXED);
+		}
+		stamp = next;
+		run = 1;
+	}
+}
+#else
+static inline void RingDwellStamp (RingBuffer_t* buffer, uint32_t ptr, size_t len){
+	(void)buffer;
+	(void)ptr;
+	(void)len;
+}
+
+static inline void RingDwellSample (RingBuffer_t* buffer, uint32_t ptr, size_t len){
+	(void)buffer;
+	(void)ptr;
+	(void)len;
+}
+#endif
+
+#ifdef __linux__
+/**< Adds one to eventfd counter, which makes it readable. */
+static void RingEventSignal (int fd){
+	uint64_t one = 1;
+	/* Fails only if counter would overflow, fd is readable then anyway. */
+	if(write(fd, &one, sizeof(one)) < 0){
+		return;
+	}
+}
+
+/**< Eventfd mode: signals reader if buffer was empty before write at pointer ptr.
+ * Called after write pointer was published. */
+static inline void RingEventWritten (RingBuffer_t* buffer, uint32_t ptr){
+	/* Pairs with fence in RingEventRead: either this sees read pointer of
+	 * drained buffer, or reader's next emptiness check sees written data. */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if(__atomic_load_n(&buffer -> readPtr, __ATOMIC_RELAXED) == ptr){
+		RingEventSignal(buffer -> readFd);
+	}
+}
+
+/**< Eventfd mode: signals writer, which got NO_PLACE, once occupancy falls
+ * below low water. Called after read pointer was published. */
+static inline void RingEventRead (RingBuffer_t* buffer){
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if(__atomic_load_n(&buffer -> writeWaiting, __ATOMIC_RELAXED) &&
+			__atomic_load_n(&buffer -> writePtr, __ATOMIC_RELAXED) -
+			__atomic_load_n(&buffer -> readPtr, __ATOMIC_RELAXED) < buffer -> lowWater &&
+			__atomic_exchange_n(&buffer -> writeWaiting, 0, __ATOMIC_ACQ_REL)){
+		RingEventSignal(buffer -> writeFd);
+	}
+}
+
+/**< Eventfd mode: remembers that writer got NO_PLACE. */
+static inline void RingEventNoPlace (RingBuffer_t* buffer){
+	__atomic_store_n(&buffer -> writeWaiting, 1, __ATOMIC_RELAXED);
+	/* Reader could free place before it saw the flag, then writer signals itself. */
+	RingEventRead(buffer);
+}
+#else
+static inline void RingEventWritten (RingBuffer_t* buffer, uint32_t ptr){
+	(void)buffer;
+	(void)ptr;
+}
+
+static inline void RingEventRead (RingBuffer_t* buffer){
+	(void)buffer;
+}
+
+static inline void RingEventNoPlace (RingBuffer_t* buffer){
+	(void)buffer;
+}
+#endif
+
+/**< Returns NO_PLACE, counting it in statistics. */
+static inline RingStatus_t RingNoPlace (RingBuffer_t* buffer){
+	RING_STAT_ADD(buffer, statNoPlace, 1);
+	if(buffer -> flags & RING_FLAG_EVENTFD){
+		RingEventNoPlace(buffer);
+	}
+	return NO_PLACE;
+}
+
+/**< Returns NO_DATA, counting it in statistics. */
+static inline RingStatus_t RingNoData (RingBuffer_t* buffer){
+	RING_STAT_ADD(buffer, statNoData, 1);
+	(void)buffer;
+	return NO_DATA;
+}
+
 uint32_t RingGetElementsCapacity (RingBuffer_t* buffer){
 	return buffer -> size;
 }
 
 uint32_t RingGetSpace (RingBuffer_t* buffer){
+	if(buffer -> mask){
+		return buffer -> size - RingGetDataCnt(buffer);
+	}
 	return buffer -> place;
 }
 
 uint32_t RingGetDataCnt (RingBuffer_t* buffer){
-	return buffer -> size - RingGetSpace(buffer);
+	if(buffer -> mask){
+		/* Pointers may be moved by the other side, in overwrite or eventfd mode. */
+		uint32_t tail = __atomic_load_n(&buffer -> readPtr, __ATOMIC_ACQUIRE);
+		return __atomic_load_n(&buffer -> writePtr, __ATOMIC_ACQUIRE) - tail;
+	}
+	return buffer -> size - 1 - RingGetSpace(buffer);
 }
 
-/* DONE: Add null pointer exceptions. */
-RingStatus_t RingInit (RingBuffer_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize){
+/**< Sets up buffer structure, array is cleared only if clear is set. */
+static RingStatus_t RingSetup (RingBuffer_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize, int clear){
 	if(NULL == buffer) return NO_PTR;
 	if(NULL == arrayBuffer) return NO_PTR;
 
@@ -52,12 +333,40 @@ RingStatus_t RingInit (RingBuffer_t* buffer, void* arrayBuffer, size_t bufferSiz
 	buffer -> elementSize = elementSize;
 	buffer -> sizeB = buffer -> elementSize * buffer -> size;
 
-	memset(buffer -> buffer, 0, buffer -> sizeB);
+	if(clear){
+		memset(buffer -> buffer, 0, buffer -> sizeB);
+	}
 	return OK;
 }
 
+/**< Switches just initialized buffer to power-of-two mode. */
+static inline void RingSetPow2 (RingBuffer_t* buffer){
+	buffer -> mask = buffer -> size - 1;
+	buffer -> place = buffer -> size;
+}
+
+/* DONE: Add null pointer exceptions. */
+RingStatus_t RingInit (RingBuffer_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize){
+	return RingSetup(buffer, arrayBuffer, bufferSize, elementSize, 1);
+}
+
+RingStatus_t RingInitPow2 (RingBuffer_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize){
+	RingStatus_t retval;
+	if(NULL == buffer) return NO_PTR;
+	if(!RingIsPow2(bufferSize)){
+		memset(buffer, 0, sizeof(RingBuffer_t));
+		return NO_DATA;
+	}
+	retval = RingInit(buffer, arrayBuffer, bufferSize, elementSize);
+	if(OK == retval){
+		RingSetPow2(buffer);
+	}
+	return retval;
+}
+
 RingStatus_t RingInitAlloc (RingBuffer_t* buffer, size_t bufferSize, size_t elementSize){
 	void* ptr;
+	RingStatus_t retval;
 	size_t reqSize = elementSize * bufferSize;
 	if(NULL == buffer){
 		return NO_PTR;
@@ -66,141 +375,1360 @@ RingStatus_t RingInitAlloc (RingBuffer_t* buffer, size_t bufferSize, size_t elem
 	if(NULL == ptr){
 		return NO_PTR;
 	}
-	return RingInit(buffer, ptr, bufferSize, elementSize);
+	retval = RingInit(buffer, ptr, bufferSize, elementSize);
+	if(OK == retval){
+		buffer -> flags |= RING_FLAG_ALLOC;
+	}else{
+		free(ptr);
+	}
+	return retval;
 }
 
-RingStatus_t RingWriteElement (RingBuffer_t* buffer, void* data){
-	RingStatus_t retval = OK;
+#ifdef __linux__
+/**< Maps zeroed anonymous memory aligned to given power of two, trimming
+ * over-allocated head and tail. Returns NULL on failure. */
+static void* RingMapAligned (size_t len, size_t align, int flags){
+	size_t extra = align;
+	uint8_t* area = mmap(NULL, len + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+	if(MAP_FAILED == area) return NULL;
+
+	uint8_t* aligned = (uint8_t*)(((uintptr_t)area + align - 1) & ~(uintptr_t)(align - 1));
+	if(aligned > area){
+		munmap(area, aligned - area);
+	}
+	if(area + len + extra > aligned + len){
+		munmap(aligned + len, area + len + extra - (aligned + len));
+	}
+	return aligned;
+}
+
+/**< Binds memory range to NUMA node, before any of its pages is touched. */
+static int RingBindNode (void* area, size_t len, int node){
+#ifdef SYS_mbind
+	unsigned long mask[16] = { 0 };
+	const size_t bits = 8 * sizeof(unsigned long);
+
+	if(node < 0 || (size_t)node >= sizeof(mask) * 8) return -1;
+	mask[node / bits] = 1ul << (node % bits);
+	return syscall(SYS_mbind, area, len, MPOL_BIND, &mask[0], sizeof(mask) * 8, 0);
+#else
+	(void)area;
+	(void)len;
+	(void)node;
+	return -1;
+#endif
+}
+
+/**< Faults in all pages of range, so first writes do not pay for it. */
+static void RingPrefault (void* area, size_t len){
+	long pageSize = sysconf(_SC_PAGESIZE);
 
+#ifdef MADV_POPULATE_WRITE
+	if(0 == madvise(area, len, MADV_POPULATE_WRITE)) return;
+#endif
+	for(size_t i = 0; i < len; i += pageSize){
+		((volatile uint8_t*)area)[i] = 0;
+	}
+}
+#endif
+
+RingStatus_t RingInitAllocEx (RingBuffer_t* buffer, size_t bufferSize, size_t elementSize, const RingAllocOptions_t* options){
+	RingStatus_t retval;
+	size_t reqSize = elementSize * bufferSize;
+	size_t align;
+	void* ptr = NULL;
+	int mapped = 0;
+
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == options){
+		return RingInitAlloc(buffer, bufferSize, elementSize);
+	}
+	align = options -> alignment;
+	if((align & (align - 1)) || (options -> pow2 && !RingIsPow2(bufferSize)) || 0 == reqSize){
+		memset(buffer, 0, sizeof(RingBuffer_t));
+		return NO_DATA;
+	}
+	if(align < sizeof(void*)){
+		align = sizeof(void*);
+	}
+
+#ifdef __linux__
+	size_t pageSize = sysconf(_SC_PAGESIZE);
+	size_t mapSize = (reqSize + pageSize - 1) / pageSize * pageSize;
+
+	if(RING_HUGE_NONE != options -> hugePages || options -> numaNode >= 0 || options -> prefault || align > pageSize){
+		if(RING_HUGE_EXPLICIT == options -> hugePages){
+			/* Huge page mappings are aligned to huge page size already. */
+			mapSize = (reqSize + RING_HUGE_PAGE_SIZE - 1) / RING_HUGE_PAGE_SIZE * RING_HUGE_PAGE_SIZE;
+			ptr = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if(MAP_FAILED == ptr) ptr = NULL;
+		}else{
+			if(RING_HUGE_TRANSPARENT == options -> hugePages && align < RING_HUGE_PAGE_SIZE){
+				align = RING_HUGE_PAGE_SIZE;
+			}
+			ptr = RingMapAligned(mapSize, align > pageSize ? align : pageSize, 0);
+			if(ptr && RING_HUGE_TRANSPARENT == options -> hugePages){
+				madvise(ptr, mapSize, MADV_HUGEPAGE);
+			}
+		}
+		if(NULL == ptr){
+			memset(buffer, 0, sizeof(RingBuffer_t));
+			return NO_PTR;
+		}
+		if(options -> numaNode >= 0 && RingBindNode(ptr, mapSize, options -> numaNode) < 0){
+			munmap(ptr, mapSize);
+			memset(buffer, 0, sizeof(RingBuffer_t));
+			return NO_PTR;
+		}
+		if(options -> prefault){
+			RingPrefault(ptr, mapSize);
+		}
+		mapped = 1;
+	}
+#endif
+	if(!mapped){
+		if(0 != posix_memalign(&ptr, align, reqSize)){
+			memset(buffer, 0, sizeof(RingBuffer_t));
+			return NO_PTR;
+		}
+	}
+
+	/* Fresh anonymous mapping is zeroed by kernel, clearing it would only fault all pages in. */
+	retval = RingSetup(buffer, ptr, bufferSize, elementSize, !mapped);
+#ifdef __linux__
+	if(mapped){
+		if(OK == retval){
+			buffer -> flags |= RING_FLAG_MAPPED;
+			buffer -> mapSize = mapSize;
+		}else{
+			munmap(ptr, mapSize);
+		}
+	}
+#endif
+	if(!mapped){
+		if(OK == retval){
+			buffer -> flags |= RING_FLAG_ALLOC;
+			if(options -> alignment || RING_HUGE_NONE != options -> hugePages || options -> numaNode >= 0 || options -> prefault){
+				buffer -> flags |= RING_FLAG_ALIGNED;
+			}
+		}else{
+			free(ptr);
+		}
+	}
+	if(OK == retval && options -> pow2){
+		RingSetPow2(buffer);
+	}
+	return retval;
+}
+
+RingStatus_t RingInitMirrored (RingBuffer_t* buffer, size_t bufferSize, size_t elementSize){
+	if(NULL == buffer) return NO_PTR;
+#ifdef __linux__
+	RingStatus_t retval;
+	size_t reqSize = elementSize * bufferSize;
+	long pageSize = sysconf(_SC_PAGESIZE);
+	uint8_t* area;
+	int fd;
+
+	if(0 == reqSize || pageSize <= 0 || reqSize % (size_t)pageSize){
+		memset(buffer, 0, sizeof(RingBuffer_t));
+		return NO_DATA;
+	}
+
+	fd = memfd_create("ring", MFD_CLOEXEC);
+	if(fd < 0) return NO_PTR;
+	if(ftruncate(fd, reqSize) < 0){
+		close(fd);
+		return NO_PTR;
+	}
+	/* Reserve address space for both copies, then put the same pages in each half. */
+	area = mmap(NULL, 2 * reqSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(MAP_FAILED == area){
+		close(fd);
+		return NO_PTR;
+	}
+	if(MAP_FAILED == mmap(area, reqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) ||
+			MAP_FAILED == mmap(area + reqSize, reqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0)){
+		munmap(area, 2 * reqSize);
+		close(fd);
+		return NO_PTR;
+	}
+	close(fd);
+
+	if(RingIsPow2(bufferSize)){
+		retval = RingInitPow2(buffer, area, bufferSize, elementSize);
+	}else{
+		retval = RingInit(buffer, area, bufferSize, elementSize);
+	}
+	if(OK == retval){
+		buffer -> flags |= RING_FLAG_MIRRORED;
+	}else{
+		munmap(area, 2 * reqSize);
+	}
+	return retval;
+#else
+	(void)bufferSize;
+	(void)elementSize;
+	memset(buffer, 0, sizeof(RingBuffer_t));
+	return NO_PTR;
+#endif
+}
+
+RingStatus_t RingSetOverwrite (RingBuffer_t* buffer, uint8_t enable){
+	if(NULL == buffer) return NO_PTR;
+	if(0 == buffer -> mask) return NO_DATA;
+	if(buffer -> flags & (RING_FLAG_ELASTIC | RING_FLAG_DWELL)) return NO_DATA;
+
+	if(enable){
+		buffer -> flags |= RING_FLAG_OVERWRITE;
+	}else{
+		buffer -> flags &= ~RING_FLAG_OVERWRITE;
+	}
+	return OK;
+}
+
+RingStatus_t RingEnableEventFd (RingBuffer_t* buffer, uint32_t lowWater){
+#ifdef __linux__
+	int readFd, writeFd;
+
+	if(NULL == buffer) return NO_PTR;
+	if(0 == buffer -> mask) return NO_DATA;
+	if(buffer -> flags & (RING_FLAG_EVENTFD | RING_FLAG_ELASTIC)) return NO_DATA;
+	if(0 == lowWater || lowWater > buffer -> size) return NO_DATA;
+
+	readFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if(readFd < 0) return IO_ERROR;
+	writeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if(writeFd < 0){
+		close(readFd);
+		return IO_ERROR;
+	}
+	buffer -> readFd = readFd;
+	buffer -> writeFd = writeFd;
+	buffer -> lowWater = lowWater;
+	buffer -> writeWaiting = 0;
+	buffer -> flags |= RING_FLAG_EVENTFD;
+	if(RingGetDataCnt(buffer)){
+		RingEventSignal(readFd);
+	}
+	return OK;
+#else
+	(void)buffer;
+	(void)lowWater;
+	return NO_PTR;
+#endif
+}
+
+int RingGetReadFd (RingBuffer_t* buffer){
+	if(NULL == buffer || 0 == (buffer -> flags & RING_FLAG_EVENTFD)) return -1;
+	return buffer -> readFd;
+}
+
+int RingGetWriteFd (RingBuffer_t* buffer){
+	if(NULL == buffer || 0 == (buffer -> flags & RING_FLAG_EVENTFD)) return -1;
+	return buffer -> writeFd;
+}
+
+uint32_t RingGetOverwriteCnt (RingBuffer_t* buffer){
+	return __atomic_load_n(&buffer -> overwritten, __ATOMIC_RELAXED);
+}
+
+RingStatus_t RingGetStats (RingBuffer_t* buffer, RingStats_t* stats){
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == stats) return NO_PTR;
+
+	memset(stats, 0, sizeof(RingStats_t));
+#ifdef RING_STATS
+	stats -> highWater = __atomic_load_n(&buffer -> statHighWater, __ATOMIC_RELAXED);
+	stats -> noPlace = __atomic_load_n(&buffer -> statNoPlace, __ATOMIC_RELAXED);
+	stats -> noData = __atomic_load_n(&buffer -> statNoData, __ATOMIC_RELAXED);
+	stats -> wrapWrites = __atomic_load_n(&buffer -> statWrapWrites, __ATOMIC_RELAXED);
+	stats -> wrapReads = __atomic_load_n(&buffer -> statWrapReads, __ATOMIC_RELAXED);
+	stats -> bytesIn = __atomic_load_n(&buffer -> statBytesIn, __ATOMIC_RELAXED);
+	stats -> bytesOut = __atomic_load_n(&buffer -> statBytesOut, __ATOMIC_RELAXED);
+	return OK;
+#else
+	return NO_DATA;
+#endif
+}
+
+RingStatus_t RingResetStats (RingBuffer_t* buffer){
+	if(NULL == buffer) return NO_PTR;
+#ifdef RING_STATS
+	__atomic_store_n(&buffer -> statHighWater, RingGetDataCnt(buffer), __ATOMIC_RELAXED);
+	__atomic_store_n(&buffer -> statNoPlace, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&buffer -> statNoData, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&buffer -> statWrapWrites, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&buffer -> statWrapReads, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&buffer -> statBytesIn, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&buffer -> statBytesOut, 0, __ATOMIC_RELAXED);
+	return OK;
+#else
+	return NO_DATA;
+#endif
+}
+
+RingStatus_t RingEnableDwell (RingBuffer_t* buffer){
+	if(NULL == buffer) return NO_PTR;
+#ifdef RING_DWELL
+	if(buffer -> flags & (RING_FLAG_OVERWRITE | RING_FLAG_ELASTIC)) return NO_DATA;
+	if(buffer -> flags & RING_FLAG_DWELL) return OK;
+
+	/* Stamps and histogram share one allocation. */
+	uint64_t* stamps = calloc(buffer -> size + RING_DWELL_BUCKETS, sizeof(uint64_t));
+	if(NULL == stamps) return NO_PTR;
+
+	/* Elements already in buffer count as written now. */
+	uint64_t now = RING_DWELL_NOW();
+	for(size_t i = 0; i < buffer -> size; i++){
+		stamps[i] = now;
+	}
+	buffer -> dwellStamps = stamps;
+	buffer -> dwellHist = stamps + buffer -> size;
+	buffer -> dwellMax = 0;
+	buffer -> flags |= RING_FLAG_DWELL;
+	return OK;
+#else
+	return NO_DATA;
+#endif
+}
+
+RingStatus_t RingGetDwell (RingBuffer_t* buffer, RingDwell_t* dwell){
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == dwell) return NO_PTR;
+
+	memset(dwell, 0, sizeof(RingDwell_t));
+#ifdef RING_DWELL
+	if(0 == (buffer -> flags & RING_FLAG_DWELL)) return NO_DATA;
+
+	/* Counters are copied first, so that percentiles come from one snapshot. */
+	uint64_t hist[RING_DWELL_BUCKETS];
+	for(uint32_t i = 0; i < RING_DWELL_BUCKETS; i++){
+		hist[i] = __atomic_load_n(&buffer -> dwellHist[i], __ATOMIC_RELAXED);
+		dwell -> count += hist[i];
+	}
+	dwell -> max = __atomic_load_n(&buffer -> dwellMax, __ATOMIC_RELAXED);
+
+	static const uint32_t permille[] = {500, 990, 999};
+	uint64_t* results[] = {&dwell -> p50, &dwell -> p99, &dwell -> p999};
+	uint64_t seen = 0;
+	uint32_t bucket = 0;
+	for(uint32_t q = 0; q < 3 && dwell -> count; q++){
+		uint64_t rank = (dwell -> count * permille[q] + 999) / 1000;
+		while(seen + hist[bucket] < rank){
+			seen += hist[bucket++];
+		}
+		uint64_t value = RingDwellBucketMax(bucket);
+		*results[q] = (value < dwell -> max) ? value : dwell -> max;
+	}
+
+	if(RingGetDataCnt(buffer)){
+		uint32_t tail = __atomic_load_n(&buffer -> readPtr, __ATOMIC_ACQUIRE);
+		uint64_t stamp = __atomic_load_n(&buffer -> dwellStamps[RingIndex(buffer, tail)], __ATOMIC_RELAXED);
+		uint64_t now = RING_DWELL_NOW();
+		dwell -> oldestAge = (now > stamp) ? (now - stamp) : 0;
+	}
+	return OK;
+#else
+	return NO_DATA;
+#endif
+}
+
+RingStatus_t RingResetDwell (RingBuffer_t* buffer){
+	if(NULL == buffer) return NO_PTR;
+#ifdef RING_DWELL
+	if(0 == (buffer -> flags & RING_FLAG_DWELL)) return NO_DATA;
+
+	for(uint32_t i = 0; i < RING_DWELL_BUCKETS; i++){
+		__atomic_store_n(&buffer -> dwellHist[i], 0, __ATOMIC_RELAXED);
+	}
+	__atomic_store_n(&buffer -> dwellMax, 0, __ATOMIC_RELAXED);
+	return OK;
+#else
+	return NO_DATA;
+#endif
+}
+
+RingStatus_t RingFree (RingBuffer_t* buffer){
+	if(NULL == buffer) return NO_PTR;
+
+	if(buffer -> flags & RING_FLAG_ALLOC){
+		free(buffer -> buffer);
+	}
+	free(buffer -> dwellStamps);
+#ifdef __linux__
+	if(buffer -> flags & RING_FLAG_MIRRORED){
+		munmap(buffer -> buffer, 2 * buffer -> sizeB);
+	}
+	if(buffer -> flags & RING_FLAG_MAPPED){
+		munmap(buffer -> buffer, buffer -> mapSize);
+	}
+	if(buffer -> flags & RING_FLAG_EVENTFD){
+		close(buffer -> readFd);
+		close(buffer -> writeFd);
+	}
+#endif
+	memset(buffer, 0, sizeof(RingBuffer_t));
+	return OK;
+}
+
+typedef void (*RingCopyFn_t)(void* dst, const void* src, size_t len);
+
+/**< Distance of software prefetch ahead of copied source, given in bytes. */
+#define RING_COPY_PREFETCH 512
+
+static void RingCopyScalar (void* dst, const void* src, size_t len){
+	memcpy(dst, src, len);
+}
+
+#ifdef RING_X86
+/* Streaming kernels copy unaligned head with memcpy, so that stores are
+ * aligned, then bypass cache with non-temporal stores. Destination is not
+ * read back by copying thread, so its lines would only evict working set. */
+__attribute__((target("sse2")))
+static void RingCopySse2 (void* dst, const void* src, size_t len){
+	uint8_t* d = dst;
+	const uint8_t* s = src;
+	size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+
+	if(len < head + 64){
+		memcpy(d, s, len);
+		return;
+	}
+	memcpy(d, s, head);
+	d += head;
+	s += head;
+	len -= head;
+	for(; len >= 64; len -= 64, d += 64, s += 64){
+		_mm_prefetch((const char*)s + RING_COPY_PREFETCH, _MM_HINT_NTA);
+		__m128i a = _mm_loadu_si128((const __m128i*)s);
+		__m128i b = _mm_loadu_si128((const __m128i*)(s + 16));
+		__m128i c = _mm_loadu_si128((const __m128i*)(s + 32));
+		__m128i e = _mm_loadu_si128((const __m128i*)(s + 48));
+		_mm_stream_si128((__m128i*)d, a);
+		_mm_stream_si128((__m128i*)(d + 16), b);
+		_mm_stream_si128((__m128i*)(d + 32), c);
+		_mm_stream_si128((__m128i*)(d + 48), e);
+	}
+	/* Streaming stores are weakly ordered, they have to be visible before
+	 * pointer is moved. */
+	_mm_sfence();
+	memcpy(d, s, len);
+}
+
+__attribute__((target("avx2")))
+static void RingCopyAvx2 (void* dst, const void* src, size_t len){
+	uint8_t* d = dst;
+	const uint8_t* s = src;
+	size_t head = (32 - ((uintptr_t)d & 31)) & 31;
+
+	if(len < head + 128){
+		memcpy(d, s, len);
+		return;
+	}
+	memcpy(d, s, head);
+	d += head;
+	s += head;
+	len -= head;
+	for(; len >= 128; len -= 128, d += 128, s += 128){
+		_mm_prefetch((const char*)s + RING_COPY_PREFETCH, _MM_HINT_NTA);
+		_mm_prefetch((const char*)s + RING_COPY_PREFETCH + 64, _MM_HINT_NTA);
+		__m256i a = _mm256_loadu_si256((const __m256i*)s);
+		__m256i b = _mm256_loadu_si256((const __m256i*)(s + 32));
+		__m256i c = _mm256_loadu_si256((const __m256i*)(s + 64));
+		__m256i e = _mm256_loadu_si256((const __m256i*)(s + 96));
+		_mm256_stream_si256((__m256i*)d, a);
+		_mm256_stream_si256((__m256i*)(d + 32), b);
+		_mm256_stream_si256((__m256i*)(d + 64), c);
+		_mm256_stream_si256((__m256i*)(d + 96), e);
+	}
+	_mm_sfence();
+	memcpy(d, s, len);
+}
+
+__attribute__((target("avx512f")))
+static void RingCopyAvx512 (void* dst, const void* src, size_t len){
+	uint8_t* d = dst;
+	const uint8_t* s = src;
+	size_t head = (64 - ((uintptr_t)d & 63)) & 63;
+
+	if(len < head + 256){
+		memcpy(d, s, len);
+		return;
+	}
+	memcpy(d, s, head);
+	d += head;
+	s += head;
+	len -= head;
+	for(; len >= 256; len -= 256, d += 256, s += 256){
+		_mm_prefetch((const char*)s + RING_COPY_PREFETCH, _MM_HINT_NTA);
+		_mm_prefetch((const char*)s + RING_COPY_PREFETCH + 64, _MM_HINT_NTA);
+		_mm_prefetch((const char*)s + RING_COPY_PREFETCH + 128, _MM_HINT_NTA);
+		_mm_prefetch((const char*)s + RING_COPY_PREFETCH + 192, _MM_HINT_NTA);
+		__m512i a = _mm512_loadu_si512((const void*)s);
+		__m512i b = _mm512_loadu_si512((const void*)(s + 64));
+		__m512i c = _mm512_loadu_si512((const void*)(s + 128));
+		__m512i e = _mm512_loadu_si512((const void*)(s + 192));
+		_mm512_stream_si512((void*)d, a);
+		_mm512_stream_si512((void*)(d + 64), b);
+		_mm512_stream_si512((void*)(d + 128), c);
+		_mm512_stream_si512((void*)(d + 192), e);
+	}
+	_mm_sfence();
+	memcpy(d, s, len);
+}
+#endif
+
+/**< Streaming copy with the best kernel CPU supports, selected on first call. */
+static void RingCopyStream (void* dst, const void* src, size_t len){
+	static RingCopyFn_t copy = NULL;
+	RingCopyFn_t fn = __atomic_load_n(&copy, __ATOMIC_RELAXED);
+
+	if(NULL == fn){
+		fn = RingCopyScalar;
+#ifdef RING_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx512f")){
+			fn = RingCopyAvx512;
+		}else if(__builtin_cpu_supports("avx2")){
+			fn = RingCopyAvx2;
+		}else if(__builtin_cpu_supports("sse2")){
+			fn = RingCopySse2;
+		}
+#endif
+		__atomic_store_n(&copy, fn, __ATOMIC_RELAXED);
+	}
+	fn(dst, src, len);
+}
+
+/**< Copies bulk data, with streaming kernel if buffer's threshold is reached. */
+static inline void RingCopy (RingBuffer_t* buffer, void* dst, const void* src, size_t len){
+	if(buffer -> copyThreshold && len >= buffer -> copyThreshold){
+		RingCopyStream(dst, src, len);
+	}else{
+		memcpy(dst, src, len);
+	}
+}
+
+RingStatus_t RingSetCopyThreshold (RingBuffer_t* buffer, size_t threshold){
+	if(NULL == buffer) return NO_PTR;
+	buffer -> copyThreshold = threshold;
+	return OK;
+}
+
+/**< Splits count of elements starting at given pointer into array spans. */
+static inline void RingGetSpans (RingBuffer_t* buffer, uint32_t ptr, RingSpan_t* spans, size_t len){
+	uint32_t index = RingIndex(buffer, ptr);
+	size_t toEnd = buffer -> size - index;
+
+	spans[0].data = (uint8_t*)buffer -> buffer + index * buffer -> elementSize;
+	if(len > toEnd && 0 == (buffer -> flags & RING_FLAG_MIRRORED)){
+		spans[0].len = toEnd;
+		spans[1].data = buffer -> buffer;
+		spans[1].len = len - toEnd;
+	}else{
+		spans[0].len = len;
+		spans[1].data = buffer -> buffer;
+		spans[1].len = 0;
+	}
+}
+
+/**< Moves write pointer, data must be already checked to fit. Written slots
+ * are not stamped with time. */
+static inline void RingStepWritePtr (RingBuffer_t* buffer, size_t len){
+	uint32_t ptr = buffer -> writePtr;
+
+	if(buffer -> mask){
+		/* Publishes data for reader running concurrently in overwrite or eventfd mode. */
+		__atomic_store_n(&buffer -> writePtr, ptr + len, __ATOMIC_RELEASE);
+	}else{
+		buffer -> writePtr = RingAdvance(buffer, ptr, len);
+		buffer -> place -= len;
+	}
+	RingStatsWrite(buffer, ptr, len);
+	if(buffer -> flags & RING_FLAG_EVENTFD){
+		RingEventWritten(buffer, ptr);
+	}
+}
+
+/**< Moves write pointer over len written elements. */
+static inline void RingMoveWritePtr (RingBuffer_t* buffer, size_t len){
+	RingDwellStamp(buffer, buffer -> writePtr, len);
+	RingStepWritePtr(buffer, len);
+}
+
+/**< Overwrite mode: makes place for len elements by dropping the oldest ones.
+ * Read pointer is moved before any slot is overwritten, so reader which still
+ * copies these slots fails its compare-and-swap in RingReadOverwrite. */
+static inline void RingDropOldest (RingBuffer_t* buffer, size_t len){
+	uint32_t tail = __atomic_load_n(&buffer -> readPtr, __ATOMIC_ACQUIRE);
+	for(;;){
+		uint32_t used = buffer -> writePtr - tail;
+		if(used + len <= buffer -> size) return;
+		uint32_t drop = used + len - buffer -> size;
+		if(__atomic_compare_exchange_n(&buffer -> readPtr, &tail, tail + drop, 0,
+				__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)){
+			__atomic_fetch_add(&buffer -> overwritten, drop, __ATOMIC_RELAXED);
+			return;
+		}
+	}
+}
+
+/**< Overwrite mode: takes len elements starting at pointer tail, read before
+ * they were copied, only if writer did not drop any element meanwhile.
+ * Returns 0 if reader was lapped, copied data may be torn then. */
+static inline int RingTakeOverwrite (RingBuffer_t* buffer, uint32_t tail, size_t len){
+	if(!__atomic_compare_exchange_n(&buffer -> readPtr, &tail, tail + len, 0,
+			__ATOMIC_ACQ_REL, __ATOMIC_RELAXED)){
+		return 0;
+	}
+	RingStatsRead(buffer, tail, len);
+	if(buffer -> flags & RING_FLAG_EVENTFD){
+		RingEventRead(buffer);
+	}
+	return 1;
+}
+
+/**< Overwrite mode: reads elements and takes them only if writer did not drop
+ * them meanwhile. Otherwise reader was lapped, and retries from oldest data. */
+static RingStatus_t RingReadOverwrite (RingBuffer_t* buffer, void* data, size_t len){
+	RingSpan_t spans[2];
+	size_t elSize = buffer -> elementSize;
+
+	for(;;){
+		uint32_t tail = __atomic_load_n(&buffer -> readPtr, __ATOMIC_ACQUIRE);
+		uint32_t head = __atomic_load_n(&buffer -> writePtr, __ATOMIC_ACQUIRE);
+		if(head - tail < len) return RingNoData(buffer);
+
+		RingGetSpans(buffer, tail, spans, len);
+		memcpy(data, spans[0].data, spans[0].len * elSize);
+		if(spans[1].len){
+			memcpy((uint8_t*)data + spans[0].len * elSize, spans[1].data, spans[1].len * elSize);
+		}
+		if(RingTakeOverwrite(buffer, tail, len)) return OK;
+	}
+}
+
+/**< Moves read pointer, data must be already checked to be in buffer. Dwell
+ * time of read slots is not counted. */
+static inline void RingStepReadPtr (RingBuffer_t* buffer, size_t len){
+	uint32_t ptr = buffer -> readPtr;
+
+	if(buffer -> mask){
+		/* Frees slots for writer running concurrently in eventfd mode. */
+		__atomic_store_n(&buffer -> readPtr, ptr + len, __ATOMIC_RELEASE);
+	}else{
+		buffer -> readPtr = RingAdvance(buffer, ptr, len);
+		buffer -> place += len;
+	}
+	/* Remembered scan position is counted from read pointer. */
+	buffer -> findScanned = (buffer -> findScanned > len) ? (buffer -> findScanned - len) : 0;
+	RingStatsRead(buffer, ptr, len);
+	if(buffer -> flags & RING_FLAG_EVENTFD){
+		RingEventRead(buffer);
+	}
+}
+
+/**< Moves read pointer over len read elements. */
+static inline void RingMoveReadPtr (RingBuffer_t* buffer, size_t len){
+	RingDwellSample(buffer, buffer -> readPtr, len);
+	RingStepReadPtr(buffer, len);
+}
+
+RingStatus_t RingSetElastic (RingBuffer_t* buffer, size_t minSize, size_t maxSize){
+	if(NULL == buffer) return NO_PTR;
+	/* RingResize reallocates with malloc and free, so arrays mapped or
+	 * aligned by RingInitAllocEx would lose their placement. */
+	if(RING_FLAG_ALLOC != (buffer -> flags & ~RING_FLAG_ELASTIC)) return NO_DATA;
+	if(minSize < 2 || minSize > buffer -> size) return NO_DATA;
+	if(maxSize < buffer -> size || maxSize > UINT32_MAX / 2) return NO_DATA;
+	if(buffer -> mask && !(RingIsPow2(minSize) && RingIsPow2(maxSize))) return NO_DATA;
+
+	buffer -> minSize = minSize;
+	buffer -> maxSize = maxSize;
+	buffer -> idleCnt = 0;
+	buffer -> flags |= RING_FLAG_ELASTIC;
+	return OK;
+}
+
+/**< Moves data of elastic buffer to new array of given size, which has to
+ * fit it. Data is linearized at array beginning with at most two copies. */
+static RingStatus_t RingResize (RingBuffer_t* buffer, size_t newSize){
+	RingSpan_t spans[2];
+	size_t elSize = buffer -> elementSize;
+	size_t cnt = RingGetDataCnt(buffer);
+	uint8_t* array = malloc(newSize * elSize);
+
+	if(NULL == array) return NO_PTR;
+	RingGetSpans(buffer, buffer -> readPtr, spans, cnt);
+	memcpy(array, spans[0].data, spans[0].len * elSize);
+	if(spans[1].len){
+		memcpy(array + spans[0].len * elSize, spans[1].data, spans[1].len * elSize);
+	}
+	free(buffer -> buffer);
+
+	buffer -> buffer = array;
+	buffer -> size = newSize;
+	buffer -> sizeB = newSize * elSize;
+	buffer -> readPtr = 0;
+	buffer -> writePtr = cnt;
+	buffer -> idleCnt = 0;
+	if(buffer -> mask){
+		buffer -> mask = newSize - 1;
+	}else{
+		buffer -> place = newSize - 1 - cnt;
+	}
+	return OK;
+}
+
+/**< Elastic mode: grows buffer until len elements fit, or up to maximum size.
+ * Returns space available afterwards. */
+static size_t RingGrow (RingBuffer_t* buffer, size_t len){
+	size_t space = RingGetSpace(buffer);
+
+	if(space >= len || 0 == (buffer -> flags & RING_FLAG_ELASTIC)) return space;
+	if(buffer -> size >= buffer -> maxSize) return space;
+
+	/* One element is kept free outside power-of-two mode. */
+	size_t need = RingGetDataCnt(buffer) + len + (buffer -> mask ? 0 : 1);
+	size_t newSize = buffer -> size;
+	while(newSize < need && newSize < buffer -> maxSize){
+		newSize *= 2;
+	}
+	if(newSize > buffer -> maxSize){
+		newSize = buffer -> maxSize;
+	}
+	if(OK == RingResize(buffer, newSize)){
+		space = RingGetSpace(buffer);
+	}
+	return space;
+}
+
+/**< Elastic mode: halves buffer once occupancy stayed at most a quarter of
+ * size for a whole buffer size of read elements. Called after reads. */
+static inline void RingShrinkIdle (RingBuffer_t* buffer, size_t len){
+	if(0 == (buffer -> flags & RING_FLAG_ELASTIC)) return;
+	if(buffer -> size <= buffer -> minSize) return;
+
+	if(RingGetDataCnt(buffer) * 4 > buffer -> size){
+		buffer -> idleCnt = 0;
+		return;
+	}
+	buffer -> idleCnt += len;
+	if(buffer -> idleCnt >= buffer -> size){
+		size_t newSize = buffer -> size / 2;
+		RingResize(buffer, (newSize < buffer -> minSize) ? buffer -> minSize : newSize);
+	}
+}
+
+RingStatus_t RingWriteReserve (RingBuffer_t* buffer, RingSpan_t* spans, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(spans == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+	if((buffer -> flags & RING_FLAG_OVERWRITE) && len <= buffer -> size){
+		RingDropOldest(buffer, len);
+	}
+	if(RingGrow(buffer, len) < len) return RingNoPlace(buffer);
+
+	RingGetSpans(buffer, buffer -> writePtr, spans, len);
+	return OK;
+}
+
+RingStatus_t RingWriteCommit (RingBuffer_t* buffer, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+	if(RingGetSpace(buffer) < len) return RingNoPlace(buffer);
+
+	RingMoveWritePtr(buffer, len);
+	return OK;
+}
+
+RingStatus_t RingReadPeek (RingBuffer_t* buffer, RingSpan_t* spans, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(spans == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+	if(RingGetDataCnt(buffer) < len) return RingNoData(buffer);
+
+	RingGetSpans(buffer, buffer -> readPtr, spans, len);
+	return OK;
+}
+
+RingStatus_t RingReadConsume (RingBuffer_t* buffer, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+	if(buffer -> flags & RING_FLAG_OVERWRITE){
+		/* Writer may move read pointer concurrently. */
+		uint32_t tail;
+		do{
+			tail = __atomic_load_n(&buffer -> readPtr, __ATOMIC_ACQUIRE);
+			if(__atomic_load_n(&buffer -> writePtr, __ATOMIC_ACQUIRE) - tail < len) return RingNoData(buffer);
+		}while(!RingTakeOverwrite(buffer, tail, len));
+		return OK;
+	}
+	if(RingGetDataCnt(buffer) < len) return RingNoData(buffer);
+
+	RingMoveReadPtr(buffer, len);
+	RingShrinkIdle(buffer, len);
+	return OK;
+}
+
+RingStatus_t RingWriteElement (RingBuffer_t* buffer, void* data){
 	if(buffer == NULL) return NO_PTR;
 	if(data == NULL) return NO_PTR;
 	if(buffer -> buffer == NULL) return NO_PTR;
 
-	uint32_t tempHead = buffer -> writePtr;
-	uint32_t tempTail = buffer -> readPtr;
 	size_t elSize = buffer -> elementSize;
-	size_t bufferSize = buffer -> sizeB;
 
-	void* wrPtr;
-	wrPtr = buffer -> buffer + tempHead;
+	if(buffer -> flags & RING_FLAG_OVERWRITE){
+		RingDropOldest(buffer, 1);
+	}else if(0 == RingGrow(buffer, 1)){
+		return RingNoPlace(buffer);
+	}
+
+	memcpy((uint8_t*)buffer -> buffer + RingIndex(buffer, buffer -> writePtr) * elSize, data, elSize);
+	RingMoveWritePtr(buffer, 1);
+	return OK;
+}
 
-	tempHead = MODULO_BUF(tempHead + elSize, bufferSize);
-	if(tempHead != tempTail){
-		memcpy(wrPtr, data, elSize);
-		buffer -> writePtr = tempHead;
-		buffer -> place --;
-	}else{
-		retval = NO_PLACE;
+RingStatus_t RingWriteElements (RingBuffer_t* buffer, void* data, size_t len){
+	RingSpan_t spans[2];
+	RingStatus_t retval;
+
+	if(data == NULL) return NO_PTR;
+	retval = RingWriteReserve(buffer, spans, len);
+	if(OK != retval) return retval;
+
+	size_t elSize = buffer -> elementSize;
+	RingCopy(buffer, spans[0].data, data, spans[0].len * elSize);
+	if(spans[1].len){
+		RingCopy(buffer, spans[1].data, (uint8_t*)data + spans[0].len * elSize, spans[1].len * elSize);
 	}
+	RingMoveWritePtr(buffer, len);
+	return OK;
+}
+
+RingStatus_t RingReadElement (RingBuffer_t* buffer, void* data){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> flags & RING_FLAG_OVERWRITE) return RingReadOverwrite(buffer, data, 1);
+
+	size_t elSize = buffer -> elementSize;
+
+	if(0 == RingGetDataCnt(buffer)) return RingNoData(buffer);
+
+	memcpy(data, (uint8_t*)buffer -> buffer + RingIndex(buffer, buffer -> readPtr) * elSize, elSize);
+	RingMoveReadPtr(buffer, 1);
+	RingShrinkIdle(buffer, 1);
+	return OK;
+}
+
+RingStatus_t RingReadElements (RingBuffer_t* buffer, void* data, size_t len){
+	RingSpan_t spans[2];
+	RingStatus_t retval;
+
+	if(data == NULL) return NO_PTR;
+	if(buffer && (buffer -> flags & RING_FLAG_OVERWRITE) && len > 0) return RingReadOverwrite(buffer, data, len);
+	retval = RingReadPeek(buffer, spans, len);
+	if(OK != retval) return retval;
+
+	size_t elSize = buffer -> elementSize;
+	RingCopy(buffer, data, spans[0].data, spans[0].len * elSize);
+	if(spans[1].len){
+		RingCopy(buffer, (uint8_t*)data + spans[0].len * elSize, spans[1].data, spans[1].len * elSize);
+	}
+	RingMoveReadPtr(buffer, len);
+	RingShrinkIdle(buffer, len);
+	if(buffer -> copyThreshold){
+		/* The next read most likely starts where this one ended. */
+		__builtin_prefetch((uint8_t*)buffer -> buffer + RingIndex(buffer, buffer -> readPtr) * elSize, 0, 3);
+	}
+	return OK;
+}
+
+RingStatus_t RingWriteSome (RingBuffer_t* buffer, const void* data, size_t len, size_t* transferred){
+	size_t space;
+	RingStatus_t retval;
+
+	if(transferred) *transferred = 0;
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+
+	/* Overwrite mode makes place by itself, up to whole buffer. */
+	space = (buffer -> flags & RING_FLAG_OVERWRITE) ? buffer -> size : RingGrow(buffer, len);
+	if(0 == space) return RingNoPlace(buffer);
+	if(len > space) len = space;
+
+	retval = RingWriteElements(buffer, (void*)data, len);
+	if(OK == retval && transferred) *transferred = len;
 	return retval;
 }
 
-RingStatus_t RingWriteElements (RingBuffer_t* buffer, void* data, size_t len){
-	RingStatus_t retval = OK;
+RingStatus_t RingReadSome (RingBuffer_t* buffer, void* data, size_t len, size_t* transferred){
+	size_t cnt;
+	RingStatus_t retval;
 
+	if(transferred) *transferred = 0;
 	if(buffer == NULL) return NO_PTR;
 	if(data == NULL) return NO_PTR;
 	if(buffer -> buffer == NULL) return NO_PTR;
 	if(len <= 0) return NO_DATA;
 
-	uint32_t tempHead = buffer -> writePtr;
-	uint32_t tempPlace = buffer -> place;
+	/* Count can only grow meanwhile, also in overwrite mode. */
+	cnt = RingGetDataCnt(buffer);
+	if(0 == cnt) return RingNoData(buffer);
+	if(len > cnt) len = cnt;
 
-	size_t elSize = buffer -> elementSize;
-	size_t bytesToWrite = elSize * len;
-	size_t bufferSize = buffer -> size;
-	size_t bufferSizeB = buffer -> sizeB;
-	uint8_t* wrPtr;
-
-	wrPtr = buffer -> buffer + tempHead;
-
-	if(tempPlace >= len){
-		if(tempHead + bytesToWrite >= bufferSizeB){
-			uint32_t temp1, temp2;
-			temp1 = bufferSizeB - tempHead;
-			memcpy(wrPtr, data, temp1);
-			data += temp1;
-			temp2 = len - temp1;
-			wrPtr = buffer -> buffer;
-			memcpy(wrPtr, data, temp2);
-		}else{
-			memcpy(wrPtr, data, len);
-			tempHead = MODULO_BUF(tempHead + len, bufferSize);
+	retval = RingReadElements(buffer, data, len);
+	if(OK == retval && transferred) *transferred = len;
+	return retval;
+}
+
+RingStatus_t RingTransfer (RingBuffer_t* dst, RingBuffer_t* src, size_t n, size_t* transferred){
+	RingSpan_t srcSpans[2];
+	RingSpan_t dstSpans[2];
+	RingStatus_t retval;
+	size_t cnt, space;
+
+	if(transferred) *transferred = 0;
+	if(dst == NULL) return NO_PTR;
+	if(src == NULL) return NO_PTR;
+	if(dst -> buffer == NULL || src -> buffer == NULL) return NO_PTR;
+	if(n <= 0 || dst -> elementSize != src -> elementSize) return NO_DATA;
+
+	cnt = RingGetDataCnt(src);
+	if(0 == cnt) return RingNoData(src);
+	space = (dst -> flags & RING_FLAG_OVERWRITE) ? dst -> size : RingGrow(dst, (n < cnt) ? n : cnt);
+	if(0 == space) return RingNoPlace(dst);
+	if(n > cnt) n = cnt;
+	if(n > space) n = space;
+
+	retval = RingWriteReserve(dst, dstSpans, n);
+	if(OK != retval) return retval;
+
+	size_t elSize = src -> elementSize;
+	for(;;){
+		uint32_t tail = __atomic_load_n(&src -> readPtr, __ATOMIC_ACQUIRE);
+		RingGetSpans(src, tail, srcSpans, n);
+
+		/* Every copy ends at end of src or dst span, so there are at most
+		 * as many copies as span boundaries, i.e. four. */
+		size_t s = 0, d = 0, sOff = 0, dOff = 0;
+		for(size_t done = 0; done < n;){
+			size_t chunk = srcSpans[s].len - sOff;
+			if(chunk > dstSpans[d].len - dOff){
+				chunk = dstSpans[d].len - dOff;
+			}
+			memcpy((uint8_t*)dstSpans[d].data + dOff * elSize, (uint8_t*)srcSpans[s].data + sOff * elSize, chunk * elSize);
+			done += chunk;
+			sOff += chunk;
+			dOff += chunk;
+			if(sOff == srcSpans[s].len){
+				s++;
+				sOff = 0;
+			}
+			if(dOff == dstSpans[d].len){
+				d++;
+				dOff = 0;
+			}
 		}
-		tempPlace -= len;
-		buffer -> writePtr = tempHead;
-		buffer -> place = tempPlace;
-	}else{
-		retval = NO_PLACE;
+
+		/* Elements are published in dst only after they were taken from src,
+		 * so on failure dst is left as it was. */
+		if(0 == (src -> flags & RING_FLAG_OVERWRITE)){
+			retval = RingReadConsume(src, n);
+			if(OK != retval) return retval;
+			break;
+		}
+		/* Writer lapped src during copy, copied data may be torn. Count of
+		 * data in overwrite mode never decreases meanwhile, so n elements are
+		 * still there, reserved place in dst is filled again. */
+		if(RingTakeOverwrite(src, tail, n)) break;
 	}
 
-	return retval;
+	RingMoveWritePtr(dst, n);
+	if(transferred) *transferred = n;
+	return OK;
 }
 
-RingStatus_t RingReadElement (RingBuffer_t* buffer, void* data){
-	RingStatus_t retval = OK;
-	uint32_t tempHead = buffer -> writePtr;
-	uint32_t tempTail = buffer -> readPtr;
-	uint32_t tempPlace = buffer -> place;
-	size_t bufferSize = buffer -> size;
-	size_t elSize = buffer -> elementSize;
-	void* wrPtr;
-	wrPtr = buffer -> buffer + tempTail;
-
-	if(tempHead != tempTail){
-		memcpy(data, wrPtr, elSize);
-		tempTail = MODULO_BUF(tempTail + 1, bufferSize);
-		tempPlace++;
-		buffer -> readPtr = tempTail;
-		buffer -> place = tempPlace;
-	}else{
-		retval = NO_DATA;
+/**< Size of record length header, given in bytes. */
+#define RING_RECORD_HDR		sizeof(uint32_t)
+/**< Length header value marking skipped rest of buffer array. */
+#define RING_RECORD_PAD		UINT32_MAX
+
+/**< Count of bytes from given pointer to array end, where record has to end. */
+static inline size_t RingRecordToEnd (RingBuffer_t* buffer, uint32_t ptr){
+	if(buffer -> flags & RING_FLAG_MIRRORED){
+		return SIZE_MAX;
 	}
-	return retval;
+	return buffer -> size - RingIndex(buffer, ptr);
 }
 
-RingStatus_t RingReadElements (RingBuffer_t* buffer, void* data, size_t len){
-	RingStatus_t retval = OK;
-	uint32_t tempHead = buffer -> writePtr;
-	uint32_t tempTail = buffer -> readPtr;
-	uint32_t tempPlace = buffer -> place;
-	uint8_t* wrPtr;
-	wrPtr = buffer -> buffer + tempHead;
-	if(tempHead != tempTail){
-		if(tempTail + len > buffer -> size - 1){
-			uint32_t temp1, temp2;
-			temp1 = buffer -> size - tempTail;
-			memcpy(data, wrPtr, temp1);
-			data += temp1;
-			temp2 = len - temp1;
-			wrPtr = buffer -> buffer;
-			memcpy(data, wrPtr, temp2);
-			tempTail = temp2;
-		}else{
-			memcpy(data, wrPtr, len);
-			tempTail += len;
+RingStatus_t RingWriteRecord (RingBuffer_t* buffer, const void* data, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0 || len >= RING_RECORD_PAD) return NO_DATA;
+	if(buffer -> elementSize != 1) return NO_DATA;
+	/* Relocation would move padding away from array end, and writer
+	 * dropping the oldest elements would cut records. */
+	if(buffer -> flags & (RING_FLAG_ELASTIC | RING_FLAG_OVERWRITE)) return NO_DATA;
+
+	uint32_t hdr = len;
+	size_t toEnd = RingRecordToEnd(buffer, buffer -> writePtr);
+	size_t pad = (toEnd < RING_RECORD_HDR + len) ? toEnd : 0;
+
+	if(RingGetSpace(buffer) < pad + RING_RECORD_HDR + len) return RingNoPlace(buffer);
+
+	if(pad){
+		if(pad >= RING_RECORD_HDR){
+			uint32_t marker = RING_RECORD_PAD;
+			memcpy((uint8_t*)buffer -> buffer + RingIndex(buffer, buffer -> writePtr), &marker, RING_RECORD_HDR);
 		}
-		tempPlace += len;
-		buffer -> readPtr = tempTail;
-		buffer -> place = tempPlace;
-	}else{
-		retval = NO_DATA;
+		/* Record is stamped by its first slot, padding as well, so that
+		 * oldest element age is known while reader stands on padding. */
+		RingDwellStamp(buffer, buffer -> writePtr, 1);
+		RingStepWritePtr(buffer, pad);
+	}
+	uint8_t* wrPtr = (uint8_t*)buffer -> buffer + RingIndex(buffer, buffer -> writePtr);
+	memcpy(wrPtr, &hdr, RING_RECORD_HDR);
+	memcpy(wrPtr + RING_RECORD_HDR, data, len);
+	RingDwellStamp(buffer, buffer -> writePtr, 1);
+	RingStepWritePtr(buffer, RING_RECORD_HDR + len);
+	return OK;
+}
+
+RingStatus_t RingPeekRecord (RingBuffer_t* buffer, void** data, size_t* len){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(len == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(buffer -> elementSize != 1) return NO_DATA;
+	if(buffer -> flags & RING_FLAG_OVERWRITE) return NO_DATA;
+
+	for(;;){
+		uint32_t hdr;
+		size_t cnt = RingGetDataCnt(buffer);
+		size_t toEnd = RingRecordToEnd(buffer, buffer -> readPtr);
+		uint8_t* rdPtr = (uint8_t*)buffer -> buffer + RingIndex(buffer, buffer -> readPtr);
+
+		if(cnt < RING_RECORD_HDR) return RingNoData(buffer);
+		if(toEnd >= RING_RECORD_HDR){
+			memcpy(&hdr, rdPtr, RING_RECORD_HDR);
+		}
+		if(toEnd < RING_RECORD_HDR || RING_RECORD_PAD == hdr){
+			/* Writer skipped rest of array, record starts at array beginning. */
+			RingStepReadPtr(buffer, toEnd);
+			continue;
+		}
+		*data = rdPtr + RING_RECORD_HDR;
+		*len = hdr;
+		return OK;
+	}
+}
+
+RingStatus_t RingConsumeRecord (RingBuffer_t* buffer){
+	void* data;
+	size_t len;
+	RingStatus_t retval = RingPeekRecord(buffer, &data, &len);
+
+	if(OK == retval){
+		RingDwellSample(buffer, buffer -> readPtr, 1);
+		RingStepReadPtr(buffer, RING_RECORD_HDR + len);
 	}
 	return retval;
 }
 
+RingStatus_t RingReadRecord (RingBuffer_t* buffer, void* data, size_t maxLen, size_t* len){
+	void* record;
+	RingStatus_t retval;
+
+	if(data == NULL) return NO_PTR;
+	if(len == NULL) return NO_PTR;
+	retval = RingPeekRecord(buffer, &record, len);
+	if(OK != retval) return retval;
+	if(*len > maxLen) return NO_PLACE;
+
+	memcpy(data, record, *len);
+	RingDwellSample(buffer, buffer -> readPtr, 1);
+	RingStepReadPtr(buffer, RING_RECORD_HDR + *len);
+	return OK;
+}
+
+/**< Searches bytes for value, returns pointer to first match or NULL. */
+typedef const uint8_t* (*RingScanFn_t)(const uint8_t* data, size_t len, uint8_t value);
+
+static const uint8_t* RingScanScalar (const uint8_t* data, size_t len, uint8_t value){
+	return memchr(data, value, len);
+}
+
+#ifdef RING_X86
+__attribute__((target("sse2")))
+static const uint8_t* RingScanSse2 (const uint8_t* data, size_t len, uint8_t value){
+	const __m128i needle = _mm_set1_epi8((char)value);
+	size_t i = 0;
+
+	for(; i + 16 <= len; i += 16){
+		int bits = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + i)), needle));
+		if(bits) return data + i + __builtin_ctz(bits);
+	}
+	return RingScanScalar(data + i, len - i, value);
+}
+
+__attribute__((target("avx2")))
+static const uint8_t* RingScanAvx2 (const uint8_t* data, size_t len, uint8_t value){
+	const __m256i needle = _mm256_set1_epi8((char)value);
+	size_t i = 0;
+
+	for(; i + 32 <= len; i += 32){
+		uint32_t bits = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + i)), needle));
+		if(bits) return data + i + __builtin_ctz(bits);
+	}
+	return RingScanSse2(data + i, len - i, value);
+}
+#endif
+
+/**< Searches bytes with the best function CPU supports, selected on first call. */
+static const uint8_t* RingScan (const uint8_t* data, size_t len, uint8_t value){
+	static RingScanFn_t scan = NULL;
+	RingScanFn_t fn = __atomic_load_n(&scan, __ATOMIC_RELAXED);
+
+	if(NULL == fn){
+		fn = RingScanScalar;
+#ifdef RING_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx2")){
+			fn = RingScanAvx2;
+		}else if(__builtin_cpu_supports("sse2")){
+			fn = RingScanSse2;
+		}
+#endif
+		__atomic_store_n(&scan, fn, __ATOMIC_RELAXED);
+	}
+	return fn(data, len, value);
+}
+
+/**< Returns byte at given position of two spans. */
+static inline uint8_t RingSpansByte (const RingSpan_t* spans, size_t pos){
+	if(pos < spans[0].len){
+		return ((const uint8_t*)spans[0].data)[pos];
+	}
+	return ((const uint8_t*)spans[1].data)[pos - spans[0].len];
+}
+
+/**< Finds value in two spans between positions from and end, returns SIZE_MAX if not found. */
+static size_t RingScanSpans (const RingSpan_t* spans, size_t from, size_t end, uint8_t value){
+	const uint8_t* found;
+
+	if(from < spans[0].len){
+		size_t stop = (end < spans[0].len) ? end : spans[0].len;
+		found = RingScan((const uint8_t*)spans[0].data + from, stop - from, value);
+		if(found) return found - (const uint8_t*)spans[0].data;
+		from = spans[0].len;
+	}
+	if(from < end){
+		found = RingScan((const uint8_t*)spans[1].data + (from - spans[0].len), end - from, value);
+		if(found) return spans[0].len + (found - (const uint8_t*)spans[1].data);
+	}
+	return SIZE_MAX;
+}
+
+/**< Returns count of bytes already known not to start pattern, forgets
+ * position of other pattern. */
+static size_t RingFindScanned (RingBuffer_t* buffer, const uint8_t* pattern, size_t len){
+	uint64_t key = 0;
+
+	memcpy(&key, pattern, len);
+	if(key != buffer -> findPattern || len != buffer -> findLen){
+		buffer -> findPattern = key;
+		buffer -> findLen = len;
+		buffer -> findScanned = 0;
+	}
+	return buffer -> findScanned;
+}
+
+/**< Searches data for pattern as RingFind, saves read pointer search started from to tail. */
+static RingStatus_t RingFindFrom (RingBuffer_t* buffer, const void* pattern, size_t len, size_t* offset, uint32_t* tail){
+	RingSpan_t spans[2];
+	const uint8_t* pat = pattern;
+
+	if(buffer == NULL) return NO_PTR;
+	if(pattern == NULL) return NO_PTR;
+	if(offset == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+	if(buffer -> elementSize != 1) return NO_DATA;
+
+	/* Patterns longer than 8 bytes are not remembered. In overwrite mode
+	 * writer can move read pointer, so scan position would be invalid. */
+	int remember = len <= sizeof(buffer -> findPattern) && 0 == (buffer -> flags & RING_FLAG_OVERWRITE);
+	*tail = __atomic_load_n(&buffer -> readPtr, __ATOMIC_ACQUIRE);
+	size_t cnt = buffer -> mask ? (__atomic_load_n(&buffer -> writePtr, __ATOMIC_ACQUIRE) - *tail) : RingGetDataCnt(buffer);
+	size_t pos = remember ? RingFindScanned(buffer, pat, len) : 0;
+	if(cnt < len) return NO_DATA;
+
+	/* Pattern can start at most at position end - 1. */
+	size_t end = cnt - len + 1;
+	RingGetSpans(buffer, *tail, spans, cnt);
+	while(pos < end){
+		pos = RingScanSpans(spans, pos, end, pat[0]);
+		if(SIZE_MAX == pos) break;
+
+		size_t i = 1;
+		while(i < len && RingSpansByte(spans, pos + i) == pat[i]){
+			i++;
+		}
+		if(i == len){
+			if(remember) buffer -> findScanned = pos;
+			*offset = pos;
+			return OK;
+		}
+		pos++;
+	}
+	if(remember) buffer -> findScanned = end;
+	return NO_DATA;
+}
+
+RingStatus_t RingFind (RingBuffer_t* buffer, const void* pattern, size_t len, size_t* offset){
+	uint32_t tail;
+	return RingFindFrom(buffer, pattern, len, offset, &tail);
+}
+
+RingStatus_t RingReadUntil (RingBuffer_t* buffer, const void* delim, size_t delimLen, void* data, size_t maxLen, size_t* len){
+	RingSpan_t spans[2];
+	RingStatus_t retval;
+	size_t offset;
+	uint32_t tail;
+
+	if(data == NULL) return NO_PTR;
+	if(len == NULL) return NO_PTR;
+	for(;;){
+		retval = RingFindFrom(buffer, delim, delimLen, &offset, &tail);
+		if(OK != retval) return retval;
+
+		*len = offset + delimLen;
+		if(*len > maxLen) return NO_PLACE;
+
+		RingGetSpans(buffer, tail, spans, *len);
+		memcpy(data, spans[0].data, spans[0].len);
+		if(spans[1].len){
+			memcpy((uint8_t*)data + spans[0].len, spans[1].data, spans[1].len);
+		}
+		if(0 == (buffer -> flags & RING_FLAG_OVERWRITE)){
+			RingMoveReadPtr(buffer, *len);
+			RingShrinkIdle(buffer, *len);
+			return OK;
+		}
+		/* Writer dropped searched data meanwhile, search again from the oldest data. */
+		if(RingTakeOverwrite(buffer, tail, *len)) return OK;
+	}
+}
+
+#ifdef __unix__
+/**< Converts at most two spans into I/O vector, returns count of used entries. */
+static inline int RingSpansToIov (RingBuffer_t* buffer, RingSpan_t* spans, struct iovec* iov){
+	iov[0].iov_base = spans[0].data;
+	iov[0].iov_len = spans[0].len * buffer -> elementSize;
+	iov[1].iov_base = spans[1].data;
+	iov[1].iov_len = spans[1].len * buffer -> elementSize;
+	return spans[1].len ? 2 : 1;
+}
+
+RingStatus_t RingWriteFromFd (RingBuffer_t* buffer, int fd, size_t maxBytes, size_t* transferred){
+	RingSpan_t spans[2];
+	struct iovec iov[2];
+	ssize_t ret;
+	size_t len;
+
+	if(transferred) *transferred = 0;
+	if(buffer == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(buffer -> elementSize != 1){
+		errno = EINVAL;
+		return IO_ERROR;
+	}
+	/* Nothing requested is not a would-block condition of descriptor. */
+	if(0 == maxBytes) return OK;
+
+	/* Elastic buffer grows for whole request, at most to its maximum size. */
+	len = RingGrow(buffer, (maxBytes < buffer -> maxSize) ? maxBytes : buffer -> maxSize);
+	if(0 == len) return RingNoPlace(buffer);
+	if(len > maxBytes) len = maxBytes;
+
+	RingGetSpans(buffer, buffer -> writePtr, spans, len);
+	do{
+		ret = readv(fd, iov, RingSpansToIov(buffer, spans, iov));
+	}while(ret < 0 && EINTR == errno);
+
+	if(ret < 0){
+		return (EAGAIN == errno || EWOULDBLOCK == errno) ? NO_DATA : IO_ERROR;
+	}
+	if(ret > 0){
+		RingMoveWritePtr(buffer, ret);
+	}
+	if(transferred) *transferred = ret;
+	return OK;
+}
+
+RingStatus_t RingReadToFd (RingBuffer_t* buffer, int fd, size_t maxBytes, size_t* transferred){
+	RingSpan_t spans[2];
+	struct iovec iov[2];
+	ssize_t ret;
+	size_t len;
+
+	if(transferred) *transferred = 0;
+	if(buffer == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	/* Data written to descriptor could not be taken back if writer dropped it
+	 * meanwhile in overwrite mode. */
+	if(buffer -> elementSize != 1 || (buffer -> flags & RING_FLAG_OVERWRITE)){
+		errno = EINVAL;
+		return IO_ERROR;
+	}
+	if(0 == maxBytes) return OK;
+
+	len = RingGetDataCnt(buffer);
+	if(0 == len) return RingNoData(buffer);
+	if(len > maxBytes) len = maxBytes;
+
+	RingGetSpans(buffer, buffer -> readPtr, spans, len);
+	do{
+		ret = writev(fd, iov, RingSpansToIov(buffer, spans, iov));
+	}while(ret < 0 && EINTR == errno);
+
+	if(ret < 0){
+		return (EAGAIN == errno || EWOULDBLOCK == errno) ? NO_PLACE : IO_ERROR;
+	}
+	if(ret > 0){
+		RingMoveReadPtr(buffer, ret);
+		RingShrinkIdle(buffer, ret);
+	}
+	if(transferred) *transferred = ret;
+	return OK;
+}
+#endif
+
 uint32_t RingGetHead (RingBuffer_t* buffer){
-	return buffer -> writePtr;
+	return RingIndex(buffer, buffer -> writePtr);
 }
 
 uint32_t RingGetTail (RingBuffer_t* buffer){
-	return buffer -> readPtr;
+	return RingIndex(buffer, buffer -> readPtr);
 }
 
 RingStatus_t RingGetLastElement(RingBuffer_t* buffer, void* element){
 	RingStatus_t ret = OK;
 	if(buffer && element){
-		memcpy(element, buffer -> buffer + buffer -> writePtr, buffer -> elementSize);
+		if(RingGetDataCnt(buffer)){
+			uint32_t last = buffer -> mask ? (buffer -> writePtr - 1) :
+				RingAdvance(buffer, buffer -> writePtr, buffer -> size - 1);
+			memcpy(element, (uint8_t*)buffer -> buffer + RingIndex(buffer, last) * buffer -> elementSize, buffer -> elementSize);
+		}else{
+			ret = NO_DATA;
+		}
 	}else{
 		ret = NO_PTR;
 	}
@@ -30,17 +30,32 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @defgroup Ring_Buffer
  * @brief FIFO ring buffer library.
  * @{
  */
 
+/**< Assumed cache line size, used to keep producer and consumer data apart. */
+#ifndef RING_CACHE_LINE
+#define RING_CACHE_LINE 64
+#endif
+
+/**< Huge page size used to align buffers for transparent huge pages. */
+#ifndef RING_HUGE_PAGE_SIZE
+#define RING_HUGE_PAGE_SIZE (2u * 1024 * 1024)
+#endif
+
 /**
  * @brief Ring buffer status enumerator.
  *
  */
 typedef enum{
+	IO_ERROR = -4, /**< Returned if file descriptor operation failed, errno is set. */
 	NO_PTR = -3, /**< Returned if null pointer was given as parameter. */
 	NO_DATA = -2, /**< Returned if there was no data to read in buffer. */
 	NO_PLACE = -1, /**< Returned if there was no place to write data in buffer. */
@@ -56,12 +71,106 @@ typedef struct{
 	size_t elementSize; /**< Size of one buffer element. */
 	size_t sizeB; /**< Size of buffer given in bytes. */
 	size_t elementsInBuffer; /**< Current count of elements in buffer. */
-	uint32_t writePtr; /**< Buffer next write pointer. */
-	uint32_t readPtr; /**< Buffer next read pointer. */
-	uint32_t place; /**< Place available in buffer. */
+	uint32_t writePtr; /**< Buffer next write pointer, given in elements. */
+	uint32_t readPtr; /**< Buffer next read pointer, given in elements. */
+	uint32_t place; /**< Place available in buffer. Not used in power-of-two mode. */
 	void* buffer; /**< Pointer to array holding ring buffer. */
+	uint32_t mask; /**< Index mask (size - 1) in power-of-two mode, 0 otherwise. */
+	uint32_t flags; /**< Internal mode and allocation flags. */
+	uint32_t overwritten; /**< Count of elements dropped in overwrite mode. */
+	size_t mapSize; /**< Size of memory mapping of RingInitAllocEx, given in bytes. */
+	uint64_t findPattern; /**< Pattern (up to 8 bytes) of last RingFind, its scan position is remembered. */
+	uint32_t findLen; /**< Length of remembered pattern, 0 if none. */
+	uint32_t findScanned; /**< Count of bytes from read pointer where remembered pattern does not start. */
+	uint32_t minSize; /**< Minimum size of elastic buffer given in elements, 0 if not elastic. */
+	uint32_t maxSize; /**< Maximum size of elastic buffer given in elements. */
+	uint32_t idleCnt; /**< Count of elements read since occupancy fell to a quarter of size. */
+	size_t copyThreshold; /**< Bulk copies of at least this many bytes use streaming stores, 0 if disabled. */
+	int readFd; /**< Eventfd signalled for reader, valid in eventfd mode only. */
+	int writeFd; /**< Eventfd signalled for writer, valid in eventfd mode only. */
+	uint32_t lowWater; /**< Writer is signalled when occupancy falls below it. */
+	uint32_t writeWaiting; /**< Set when write returned NO_PLACE, until writer is signalled. */
+	uint64_t statNoPlace; /**< Writer side statistics, see RingStats_t. Declared also without RING_STATS, so layout of handle does not depend on it. */
+	uint64_t statWrapWrites;
+	uint64_t statBytesIn;
+	uint32_t statHighWater;
+	uint64_t statNoData; /**< Reader side statistics, see RingStats_t. */
+	uint64_t statWrapReads;
+	uint64_t statBytesOut;
+	uint64_t* dwellStamps; /**< Write time of every slot, NULL if dwell tracking is disabled or compiled out. */
+	uint64_t* dwellHist; /**< Dwell time histogram, RING_DWELL_BUCKETS counters. */
+	uint64_t dwellMax; /**< Longest dwell time read. */
 } RingBuffer_t;
 
+/**
+ * @brief Buffer statistics, collected if library is compiled with RING_STATS.
+ *
+ */
+typedef struct{
+	uint32_t highWater; /**< Highest count of elements that was in buffer. */
+	uint64_t noPlace; /**< Count of writes that returned NO_PLACE. */
+	uint64_t noData; /**< Count of reads that returned NO_DATA. */
+	uint64_t wrapWrites; /**< Count of writes split at array end. */
+	uint64_t wrapReads; /**< Count of reads split at array end. */
+	uint64_t bytesIn; /**< Count of bytes written to buffer array. */
+	uint64_t bytesOut; /**< Count of bytes taken from buffer array. */
+} RingStats_t;
+
+/**< Count of linear sub-buckets of every power of two in dwell time histogram,
+ * given as power of two. Relative error of percentiles is at most 1 / 2^bits. */
+#define RING_DWELL_SUB_BITS 3
+
+/**< Count of dwell time histogram buckets, enough for any 64-bit time. */
+#define RING_DWELL_BUCKETS ((64 - RING_DWELL_SUB_BITS + 1) << RING_DWELL_SUB_BITS)
+
+/**
+ * @brief Queueing latency, collected if library is compiled with RING_DWELL.
+ *
+ * Times are given in units of RING_DWELL_NOW, nanoseconds by default.
+ */
+typedef struct{
+	uint64_t count; /**< Count of elements (or records) read. */
+	uint64_t p50; /**< Median time between write and read. */
+	uint64_t p99; /**< 99th percentile of time between write and read. */
+	uint64_t p999; /**< 99.9th percentile of time between write and read. */
+	uint64_t max; /**< Longest time between write and read. */
+	uint64_t oldestAge; /**< Time since the oldest unread element was written, 0 if buffer is empty. */
+} RingDwell_t;
+
+/**
+ * @brief Huge page usage of RingInitAllocEx.
+ *
+ */
+typedef enum{
+	RING_HUGE_NONE = 0, /**< Regular pages. */
+	RING_HUGE_TRANSPARENT, /**< Array aligned to RING_HUGE_PAGE_SIZE and advised for transparent huge pages. */
+	RING_HUGE_EXPLICIT /**< Array mapped from reserved huge pages (MAP_HUGETLB), fails if none are free. */
+} RingHugePages_t;
+
+/**
+ * @brief Options of RingInitAllocEx.
+ *
+ */
+typedef struct{
+	size_t alignment; /**< Array alignment given in bytes, power of two, e.g. RING_CACHE_LINE; 0 for malloc default. */
+	RingHugePages_t hugePages; /**< Huge page usage. */
+	int numaNode; /**< NUMA node to bind array memory to, -1 for default policy. */
+	uint8_t prefault; /**< 1 to fault in all pages during initialization, not on first use. */
+	uint8_t pow2; /**< 1 to initialize in power-of-two mode, bufferSize must be power of two then. */
+} RingAllocOptions_t;
+
+/**< Default allocation options, to be modified before RingInitAllocEx. */
+#define RING_ALLOC_OPTIONS_INIT { 0, RING_HUGE_NONE, -1, 0, 0 }
+
+/**
+ * @brief Contiguous part of buffer array, used by zero-copy functions.
+ *
+ */
+typedef struct{
+	void* data; /**< Pointer to first element of span. */
+	size_t len; /**< Length of span given in elements. */
+} RingSpan_t;
+
 /**
  * Function that returns size of whole ring buffer.
  *
@@ -97,6 +206,21 @@ uint32_t RingGetDataCnt (RingBuffer_t* buffer);
  */
 RingStatus_t RingInit (RingBuffer_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize);
 
+/**
+ * @brief Function to initialize ring buffer in power-of-two mode.
+ *
+ * In this mode write and read pointers are free-running 32-bit counters,
+ * masked on every array access, so no division is done and whole array
+ * capacity is usable. All other functions work with such buffer unchanged.
+ *
+ * @param buffer Pointer to buffer structure that has to be initialized.
+ * @param arrayBuffer Pointer to array used by buffer
+ * @param bufferSize Size of buffer given in elements, power of two, at least 2.
+ * @param elementSize Size of one element
+ * @return RingStatus_t NO_DATA if bufferSize is not a power of two.
+ */
+RingStatus_t RingInitPow2 (RingBuffer_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize);
+
 /**
  * @brief Function to initialize ring buffer with memory allocation
  *
@@ -107,6 +231,219 @@ RingStatus_t RingInit (RingBuffer_t* buffer, void* arrayBuffer, size_t bufferSiz
  */
 RingStatus_t RingInitAlloc (RingBuffer_t* buffer, size_t bufferSize, size_t elementSize);
 
+/**
+ * @brief Function to initialize ring buffer with memory allocation tuned by options.
+ *
+ * On Linux, if huge pages, NUMA node, prefault or alignment above page size
+ * is requested, array is mapped with mmap. Such memory is already zeroed, so
+ * it is not cleared again. NUMA binding is done with mbind before any page is
+ * touched. Otherwise, and on other systems (where huge pages and NUMA node
+ * are ignored), aligned heap allocation is used. Buffer has to be released
+ * with RingFree.
+ *
+ * @param buffer Pointer to buffer structure that has to be initialized.
+ * @param bufferSize Size of buffer given in elements
+ * @param elementSize Size of one element
+ * @param options Allocation options, NULL works as RingInitAlloc.
+ * @return RingStatus_t NO_DATA if options are invalid, NO_PTR if memory could
+ * not be allocated or bound to NUMA node.
+ */
+RingStatus_t RingInitAllocEx (RingBuffer_t* buffer, size_t bufferSize, size_t elementSize, const RingAllocOptions_t* options);
+
+/**
+ * @brief Function to initialize ring buffer on mirrored memory mapping (Linux only).
+ *
+ * Buffer array is mapped twice, back to back, so elements behind array end
+ * are the same as at its beginning. Every write or read of up to buffer size
+ * is then one contiguous span, and zero-copy functions never split data.
+ * Power-of-two mode is used if bufferSize is a power of two.
+ * Buffer has to be released with RingFree.
+ *
+ * @param buffer Pointer to buffer structure that has to be initialized.
+ * @param bufferSize Size of buffer given in elements
+ * @param elementSize Size of one element
+ * @return RingStatus_t NO_DATA if size in bytes is not a multiple of page size,
+ * NO_PTR if mapping could not be created.
+ */
+RingStatus_t RingInitMirrored (RingBuffer_t* buffer, size_t bufferSize, size_t elementSize);
+
+/**
+ * @brief Enables or disables overwrite (lossy) mode of power-of-two buffer.
+ *
+ * In overwrite mode writes of up to buffer size always succeed: if there is
+ * no place, the oldest elements are dropped and counted by RingGetOverwriteCnt.
+ * One writer and one reader may then run in separate threads without lock.
+ * Reader lapped by writer notices it (its read pointer was moved) and retries
+ * element/multiple elements reads and RingReadUntil from the oldest data left.
+ * Zero-copy reader should compare RingGetOverwriteCnt before RingReadPeek and
+ * after using the data, as peeked elements could have been overwritten
+ * meanwhile. Records and RingReadToFd can not be used in overwrite mode.
+ *
+ * @param buffer Pointer to buffer structure, initialized in power-of-two mode.
+ * @param enable 1 to enable, 0 to disable.
+ * @return RingStatus_t NO_DATA if buffer is not in power-of-two mode or is elastic.
+ */
+RingStatus_t RingSetOverwrite (RingBuffer_t* buffer, uint8_t enable);
+
+/**
+ * @brief Attaches eventfds to power-of-two buffer, for epoll or io_uring loops (Linux only).
+ *
+ * Read fd is signalled when write makes empty buffer non-empty. Write fd is
+ * signalled when occupancy falls below lowWater after a write returned
+ * NO_PLACE. Notifications coalesce: reader has to read eventfd (to reset it)
+ * and then read buffer until NO_DATA, writer has to write until NO_PLACE.
+ * One writer thread and one reader thread may use buffer then without lock.
+ * Eventfds are closed by RingFree.
+ *
+ * @param buffer Pointer to buffer structure, initialized in power-of-two mode.
+ * @param lowWater Occupancy given in elements, from 1 to buffer size.
+ * @return RingStatus_t NO_DATA if buffer is not in power-of-two mode, is
+ * elastic or has eventfds already, IO_ERROR if eventfd failed (errno is set).
+ */
+RingStatus_t RingEnableEventFd (RingBuffer_t* buffer, uint32_t lowWater);
+
+/**
+ * @brief Returns eventfd signalled when data arrives in empty buffer.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return int Descriptor, -1 if eventfd mode is not enabled.
+ */
+int RingGetReadFd (RingBuffer_t* buffer);
+
+/**
+ * @brief Returns eventfd signalled when place frees up in buffer that was full.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return int Descriptor, -1 if eventfd mode is not enabled.
+ */
+int RingGetWriteFd (RingBuffer_t* buffer);
+
+/**
+ * @brief Sets size from which bulk writes and reads use streaming copy.
+ *
+ * Copies of at least threshold bytes (per span) in RingWriteElements and
+ * RingReadElements use SSE2/AVX2/AVX-512 kernel, selected at run time, with
+ * non-temporal stores that bypass cache and prefetch of source ahead, so
+ * large transfers do not evict working set of copying thread. Smaller copies
+ * use memcpy.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @param threshold Size given in bytes, 0 disables streaming copy (default).
+ * @return RingStatus_t
+ */
+RingStatus_t RingSetCopyThreshold (RingBuffer_t* buffer, size_t threshold);
+
+/**
+ * @brief Enables elastic mode of buffer allocated by RingInitAlloc.
+ *
+ * Buffers of RingInitAllocEx can be elastic only if they were allocated
+ * without alignment, huge page, NUMA or prefault options, as new arrays
+ * come from malloc.
+ *
+ * Write which does not fit doubles buffer size (repeatedly, up to maxSize)
+ * instead of returning NO_PLACE. When occupancy stays at most a quarter of
+ * size while a whole buffer size of elements is read, size is halved (down
+ * to minSize). Data is moved to new array in at most two copies, keeping
+ * order, so resizing is amortized O(1) per element. Spans and pointers got
+ * from buffer are invalid after any write or read. Records and overwrite
+ * mode can not be used with elastic buffer.
+ *
+ * @param buffer Pointer to buffer structure, initialized by RingInitAlloc.
+ * @param minSize Minimum size given in elements, at most current size.
+ * @param maxSize Maximum size given in elements, at least current size.
+ * In power-of-two mode both have to be powers of two.
+ * @return RingStatus_t NO_DATA if buffer was not allocated by library (or was
+ * allocated with RingInitAllocEx options), is in overwrite mode, or sizes are invalid.
+ */
+RingStatus_t RingSetElastic (RingBuffer_t* buffer, size_t minSize, size_t maxSize);
+
+/**
+ * @brief Returns count of elements dropped in overwrite mode.
+ *
+ * Reader can compare it before and after read to detect it was lapped.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return uint32_t Count of overwritten elements since initialization.
+ */
+uint32_t RingGetOverwriteCnt (RingBuffer_t* buffer);
+
+/**
+ * @brief Reads buffer statistics.
+ *
+ * Statistics are collected only if library is compiled with RING_STATS
+ * defined, otherwise counters stay zero and cost nothing. Writer and reader
+ * update their own counters without locks, so this function may be called
+ * from any thread, e.g. by metrics scraper.
+ * Returned values are a snapshot, counters are read one by one.
+ * Bytes in/out include record headers and padding of record mode.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @param stats Pointer to save statistics.
+ * @return RingStatus_t NO_DATA if library is compiled without RING_STATS
+ * (stats are zeroed then).
+ */
+RingStatus_t RingGetStats (RingBuffer_t* buffer, RingStats_t* stats);
+
+/**
+ * @brief Clears buffer statistics. High-water mark is set to current count of elements.
+ *
+ * Counters are not updated atomically by writer and reader, so reset done
+ * while they run may be partially lost. Scrapers running concurrently should
+ * rather compute differences between RingGetStats results.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return RingStatus_t NO_DATA if library is compiled without RING_STATS.
+ */
+RingStatus_t RingResetStats (RingBuffer_t* buffer);
+
+/**
+ * @brief Enables tracking of time elements spend in buffer.
+ *
+ * Available only if library (and code including ring.h) is compiled with
+ * RING_DWELL defined, otherwise nothing is tracked and nothing is added to
+ * buffer structure. Write time of every element is kept in side array, so
+ * payload is not changed. Reads add dwell times to log-linear histogram of
+ * buffer. Records are stamped once, by their header. Clock is read once per
+ * write or read call. It is CLOCK_MONOTONIC in nanoseconds, other clock (e.g.
+ * cycle counter) can be given by defining RING_DWELL_NOW() when compiling library.
+ * Can not be used together with overwrite or elastic mode.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return RingStatus_t NO_DATA if library is compiled without RING_DWELL or
+ * buffer is in overwrite or elastic mode, NO_PTR if allocation failed.
+ */
+RingStatus_t RingEnableDwell (RingBuffer_t* buffer);
+
+/**
+ * @brief Reads queueing latency percentiles and age of the oldest element.
+ *
+ * Histogram is updated by reader only, without locks, so this function may be
+ * called from any thread. Percentiles are upper bounds of histogram buckets.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @param dwell Pointer to save latency.
+ * @return RingStatus_t NO_DATA if dwell tracking is not enabled (dwell is zeroed then).
+ */
+RingStatus_t RingGetDwell (RingBuffer_t* buffer, RingDwell_t* dwell);
+
+/**
+ * @brief Clears dwell time histogram, with the same caveats as RingResetStats.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return RingStatus_t NO_DATA if dwell tracking is not enabled.
+ */
+RingStatus_t RingResetDwell (RingBuffer_t* buffer);
+
+/**
+ * @brief Releases memory of buffer initialized with RingInitAlloc(Ex) or RingInitMirrored.
+ *
+ * Buffers initialized on user array are only cleared.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return RingStatus_t
+ */
+RingStatus_t RingFree (RingBuffer_t* buffer);
+
 /**
  * @brief Addes one byte to the end of buffer.
  *
@@ -121,7 +458,7 @@ RingStatus_t RingWriteElement (RingBuffer_t* buffer, void* data);
  *
  * @param buffer Buffer to write data.
  * @param data Data pointer to write.
- * @param len Length of data.
+ * @param len Length of data given in elements.
  * @return RingStatus_t Write status.
  */
 RingStatus_t RingWriteElements (RingBuffer_t* buffer, void* data, size_t len);
@@ -140,16 +477,222 @@ RingStatus_t RingReadElement (RingBuffer_t* buffer, void* data);
  *
  * @param buffer Buffer to read data.
  * @param data Pointer to write data.
- * @param len Length of data to read.
+ * @param len Length of data to read given in elements.
  * @return RingStatus_t Read status.
  */
 RingStatus_t RingReadElements (RingBuffer_t* buffer, void* data, size_t len);
 
+/**
+ * @brief Writes as many elements as fit in buffer, at most len.
+ *
+ * @param buffer Buffer to write data.
+ * @param data Data pointer to write.
+ * @param len Count of elements to write.
+ * @param transferred Pointer to save count of elements written, may be NULL.
+ * @return RingStatus_t OK if at least one element was written, NO_PLACE if buffer is full.
+ */
+RingStatus_t RingWriteSome (RingBuffer_t* buffer, const void* data, size_t len, size_t* transferred);
+
+/**
+ * @brief Reads as many elements as there are in buffer, at most len.
+ *
+ * @param buffer Buffer to read data.
+ * @param data Pointer to write data.
+ * @param len Count of elements to read.
+ * @param transferred Pointer to save count of elements read, may be NULL.
+ * @return RingStatus_t OK if at least one element was read, NO_DATA if buffer is empty.
+ */
+RingStatus_t RingReadSome (RingBuffer_t* buffer, void* data, size_t len, size_t* transferred);
+
+/**
+ * @brief Moves elements from one buffer to another, without intermediate copy.
+ *
+ * As many elements as are in src and fit in dst are moved, at most n. Data
+ * is copied span to span, with at most four memcpy calls. Elements appear in
+ * dst only after they were taken from src. If src is in overwrite mode and
+ * its writer laps the copy, it is repeated from the oldest data.
+ *
+ * @param dst Buffer to write data.
+ * @param src Buffer to read data, with the same element size as dst.
+ * @param n Maximum count of elements to move.
+ * @param transferred Pointer to save count of elements moved, may be NULL.
+ * @return RingStatus_t OK if at least one element was moved, NO_DATA if src
+ * is empty or element sizes differ, NO_PLACE if dst is full.
+ */
+RingStatus_t RingTransfer (RingBuffer_t* dst, RingBuffer_t* src, size_t n, size_t* transferred);
+
+/**
+ * @brief Reserves place for elements, without copying anything.
+ *
+ * Place is given as up to two contiguous spans of buffer array, second one
+ * is used only if reserved place wraps around array end (otherwise its
+ * length is 0). Data written to spans becomes readable after RingWriteCommit.
+ *
+ * @param buffer Buffer to write data.
+ * @param spans Array of two spans to fill.
+ * @param len Count of elements to reserve.
+ * @return RingStatus_t NO_PLACE if there is less than len elements free.
+ */
+RingStatus_t RingWriteReserve (RingBuffer_t* buffer, RingSpan_t* spans, size_t len);
+
+/**
+ * @brief Publishes elements written to spans returned by RingWriteReserve.
+ *
+ * @param buffer Buffer to write data.
+ * @param len Count of elements to publish, at most reserved count.
+ * @return RingStatus_t Write status.
+ */
+RingStatus_t RingWriteCommit (RingBuffer_t* buffer, size_t len);
+
+/**
+ * @brief Gives access to data in buffer, without copying or taking it.
+ *
+ * Data is given as up to two contiguous spans of buffer array, second one
+ * is used only if data wraps around array end (otherwise its length is 0).
+ *
+ * @param buffer Buffer to read data.
+ * @param spans Array of two spans to fill.
+ * @param len Count of elements to peek.
+ * @return RingStatus_t NO_DATA if there is less than len elements in buffer.
+ */
+RingStatus_t RingReadPeek (RingBuffer_t* buffer, RingSpan_t* spans, size_t len);
+
+/**
+ * @brief Takes from buffer elements returned by RingReadPeek.
+ *
+ * @param buffer Buffer to read data.
+ * @param len Count of elements to take.
+ * @return RingStatus_t Read status.
+ */
+RingStatus_t RingReadConsume (RingBuffer_t* buffer, size_t len);
+
+/**
+ * @brief Writes variable length record to byte buffer.
+ *
+ * Record is stored as 4 byte length header followed by payload, always
+ * contiguous in buffer array. If record does not fit before array end,
+ * rest of array is skipped (marked with padding header if there is place
+ * for it) and record is written at array beginning. Mirrored buffers never
+ * need padding.
+ *
+ * @param buffer Buffer to write data, with one byte elements.
+ * @param data Record payload.
+ * @param len Length of record payload given in bytes.
+ * @return RingStatus_t NO_PLACE if there is no contiguous place for record,
+ * NO_DATA if buffer is elastic or in overwrite mode.
+ */
+RingStatus_t RingWriteRecord (RingBuffer_t* buffer, const void* data, size_t len);
+
+/**
+ * @brief Gives access to the oldest record in place, without copying or taking it.
+ *
+ * @param buffer Buffer to read data, with one byte elements.
+ * @param data Pointer to save pointer to record payload in buffer array.
+ * @param len Pointer to save record payload length given in bytes.
+ * @return RingStatus_t NO_DATA if there is no record in buffer or buffer is
+ * in overwrite mode.
+ */
+RingStatus_t RingPeekRecord (RingBuffer_t* buffer, void** data, size_t* len);
+
+/**
+ * @brief Takes from buffer the oldest record, returned before by RingPeekRecord.
+ *
+ * @param buffer Buffer to read data, with one byte elements.
+ * @return RingStatus_t NO_DATA if there is no record in buffer.
+ */
+RingStatus_t RingConsumeRecord (RingBuffer_t* buffer);
+
+/**
+ * @brief Reads the oldest record from buffer.
+ *
+ * @param buffer Buffer to read data, with one byte elements.
+ * @param data Pointer to write record payload.
+ * @param maxLen Size of data array given in bytes.
+ * @param len Pointer to save record payload length given in bytes.
+ * @return RingStatus_t NO_DATA if there is no record in buffer, NO_PLACE if
+ * record is longer than maxLen (record is left in buffer, its length is saved).
+ */
+RingStatus_t RingReadRecord (RingBuffer_t* buffer, void* data, size_t maxLen, size_t* len);
+
+/**
+ * @brief Finds pattern in byte buffer, without taking any data.
+ *
+ * Data is searched in place (one or two spans of buffer array) with SIMD
+ * instructions when CPU supports them (SSE2/AVX2, selected at run time),
+ * scalar code otherwise. Scan position of last pattern (up to 8 bytes long)
+ * is remembered, so polling for the same pattern after more data arrived
+ * does not scan old bytes again. Not remembered in overwrite mode.
+ *
+ * @param buffer Buffer to search, with one byte elements.
+ * @param pattern Pattern to find.
+ * @param len Length of pattern given in bytes.
+ * @param offset Pointer to save position of pattern, counted in bytes from the oldest one.
+ * @return RingStatus_t NO_DATA if pattern is not in buffer.
+ */
+RingStatus_t RingFind (RingBuffer_t* buffer, const void* pattern, size_t len, size_t* offset);
+
+/**
+ * @brief Reads data from byte buffer up to and including delimiter.
+ *
+ * Useful for line or frame based protocols, e.g. UART receive buffer.
+ * Delimiter is found with RingFind. In overwrite mode data is taken only if
+ * writer did not drop any of it meanwhile, otherwise search is repeated from
+ * the oldest data, which may start in the middle of a line.
+ *
+ * @param buffer Buffer to read data, with one byte elements.
+ * @param delim Delimiter, e.g. "\n" or frame sync bytes.
+ * @param delimLen Length of delimiter given in bytes.
+ * @param data Pointer to write data.
+ * @param maxLen Size of data array given in bytes.
+ * @param len Pointer to save length of data with delimiter, given in bytes.
+ * @return RingStatus_t NO_DATA if there is no delimiter in buffer, NO_PLACE
+ * if data is longer than maxLen (data is left in buffer, its length is saved).
+ */
+RingStatus_t RingReadUntil (RingBuffer_t* buffer, const void* delim, size_t delimLen, void* data, size_t maxLen, size_t* len);
+
+#ifdef __unix__
+/**
+ * @brief Fills buffer with data read from file descriptor, without intermediate copy.
+ *
+ * Free place of buffer array (one or two spans) is passed to one readv call.
+ * Only buffers with one byte elements are supported. Non-blocking descriptors
+ * and partial reads are handled, write pointer is moved by bytes actually read.
+ * Elastic buffer grows first, so that up to maxBytes fit.
+ *
+ * @param buffer Buffer to write data.
+ * @param fd File descriptor to read from.
+ * @param maxBytes Maximum count of bytes to read.
+ * @param transferred Pointer to save count of bytes read, may be NULL.
+ * @return RingStatus_t OK (with 0 bytes transferred on end of file or if
+ * maxBytes is 0), NO_PLACE if buffer is full, NO_DATA if descriptor would block,
+ * IO_ERROR on other errors (errno is set).
+ */
+RingStatus_t RingWriteFromFd (RingBuffer_t* buffer, int fd, size_t maxBytes, size_t* transferred);
+
+/**
+ * @brief Drains buffer data to file descriptor, without intermediate copy.
+ *
+ * Data in buffer array (one or two spans) is passed to one writev call.
+ * Only buffers with one byte elements are supported. Non-blocking descriptors
+ * and partial writes are handled, read pointer is moved by bytes actually written.
+ *
+ * @param buffer Buffer to read data.
+ * @param fd File descriptor to write to.
+ * @param maxBytes Maximum count of bytes to write.
+ * @param transferred Pointer to save count of bytes written, may be NULL.
+ * @return RingStatus_t OK (with 0 bytes transferred if maxBytes is 0),
+ * NO_DATA if buffer is empty, NO_PLACE if descriptor
+ * would block, IO_ERROR on other errors (errno is set, EINVAL if buffer is
+ * in overwrite mode).
+ */
+RingStatus_t RingReadToFd (RingBuffer_t* buffer, int fd, size_t maxBytes, size_t* transferred);
+#endif
+
 /**
  * @brief Returns write pointer of buffer.
  *
  * @param buffer Buffer to get pointer.
- * @return uint32_t Write pointer.
+ * @return uint32_t Write pointer, as array index given in elements.
  */
 uint32_t RingGetHead (RingBuffer_t* buffer);
 
@@ -157,7 +700,7 @@ uint32_t RingGetHead (RingBuffer_t* buffer);
  * @brief Returns read pointer of buffer.
  *
  * @param buffer Buffer to get pointer.
- * @return uint32_t Read pointer.
+ * @return uint32_t Read pointer, as array index given in elements.
  */
 uint32_t RingGetTail (RingBuffer_t* buffer);
 
@@ -165,7 +708,8 @@ uint32_t RingGetTail (RingBuffer_t* buffer);
  * @brief Gets last element from buffer without taking it from buffer.
  *
  * @param buffer Buffer to read.
- * @return uint32_t Last byte in buffer.
+ * @param element Pointer to save most recently written element.
+ * @return RingStatus_t NO_DATA if buffer is empty.
  */
 RingStatus_t RingGetLastElement(RingBuffer_t* buffer, void* element);
 
@@ -173,4 +717,9 @@ RingStatus_t RingGetLastElement(RingBuffer_t* buffer, void* element);
  * @}
  *
  */
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* RING_H_ */
@@ -0,0 +1,158 @@
+/**
+ * @file ring_arena.c
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Slab arena of compact ring buffers source file.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+/**
+ * @copyright GNU General Public License v3.0
+ * @{
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ring_arena.h"
+
+/**< Free list end marker. */
+#define RING_ARENA_NONE UINT32_MAX
+
+/**< Rounds value up to multiple of cache line. */
+static inline size_t RingArenaAlign (size_t value){
+	return (value + RING_CACHE_LINE - 1) & ~(size_t)(RING_CACHE_LINE - 1);
+}
+
+/**< Array of buffer, given by its header. */
+static inline uint8_t* RingArenaArray (RingArena_t* arena, const RingCompact_t* ring){
+	return arena -> data + (size_t)ring -> index * arena -> stride;
+}
+
+RingStatus_t RingArenaInit (RingArena_t* arena, size_t count, size_t bufferSize, size_t elementSize){
+	void* slab;
+
+	if(NULL == arena) return NO_PTR;
+	memset(arena, 0, sizeof(RingArena_t));
+	if(0 == count || count >= RING_ARENA_NONE) return NO_DATA;
+	if(bufferSize < 2 || 0 != (bufferSize & (bufferSize - 1)) || bufferSize > UINT32_MAX / 2) return NO_DATA;
+	if(0 == elementSize) return NO_DATA;
+
+	/* Arrays start on cache lines, so adjacent buffers do not share them.
+	 * Sizes which do not fit in size_t could never be allocated. */
+	size_t headers, stride, slabSize;
+	if(__builtin_mul_overflow(count, sizeof(RingCompact_t), &headers) || headers > SIZE_MAX - RING_CACHE_LINE) return NO_PTR;
+	if(__builtin_mul_overflow(bufferSize, elementSize, &stride) || stride > SIZE_MAX - RING_CACHE_LINE) return NO_PTR;
+	headers = RingArenaAlign(headers);
+	stride = RingArenaAlign(stride);
+	if(__builtin_mul_overflow(count, stride, &slabSize) || __builtin_add_overflow(slabSize, headers, &slabSize)) return NO_PTR;
+	if(0 != posix_memalign(&slab, RING_CACHE_LINE, slabSize)) return NO_PTR;
+
+	arena -> rings = slab;
+	arena -> data = (uint8_t*)slab + headers;
+	arena -> elementSize = elementSize;
+	arena -> stride = stride;
+	arena -> count = count;
+	arena -> size = bufferSize;
+	for(uint32_t i = 0; i < count; i++){
+		arena -> rings[i].writePtr = (i + 1 < count) ? i + 1 : RING_ARENA_NONE;
+		arena -> rings[i].readPtr = 0;
+		arena -> rings[i].mask = 0;
+		arena -> rings[i].index = i;
+	}
+	arena -> freeHead = 0;
+	return OK;
+}
+
+RingStatus_t RingArenaFree (RingArena_t* arena){
+	if(NULL == arena) return NO_PTR;
+	free(arena -> rings);
+	memset(arena, 0, sizeof(RingArena_t));
+	return OK;
+}
+
+RingCompact_t* RingArenaAlloc (RingArena_t* arena){
+	if(NULL == arena) return NULL;
+	if(RING_ARENA_NONE == arena -> freeHead || NULL == arena -> rings) return NULL;
+
+	RingCompact_t* ring = &arena -> rings[arena -> freeHead];
+	arena -> freeHead = ring -> writePtr;
+	arena -> used++;
+	ring -> writePtr = 0;
+	ring -> readPtr = 0;
+	ring -> mask = arena -> size - 1;
+	return ring;
+}
+
+RingStatus_t RingArenaRelease (RingArena_t* arena, RingCompact_t* ring){
+	if(NULL == arena) return NO_PTR;
+	if(NULL == ring) return NO_PTR;
+	if(ring < arena -> rings || ring >= arena -> rings + arena -> count) return NO_DATA;
+	if(0 == ring -> mask) return NO_DATA;
+
+	ring -> mask = 0;
+	ring -> writePtr = arena -> freeHead;
+	arena -> freeHead = ring -> index;
+	arena -> used--;
+	return OK;
+}
+
+uint32_t RingCompactGetDataCnt (const RingCompact_t* ring){
+	return ring -> writePtr - ring -> readPtr;
+}
+
+uint32_t RingCompactGetSpace (const RingCompact_t* ring){
+	return ring -> mask + 1 - (ring -> writePtr - ring -> readPtr);
+}
+
+RingStatus_t RingCompactWriteElements (RingArena_t* arena, RingCompact_t* ring, const void* data, size_t len){
+	if(NULL == arena) return NO_PTR;
+	if(NULL == ring) return NO_PTR;
+	if(NULL == data) return NO_PTR;
+	if(len <= 0 || 0 == ring -> mask) return NO_DATA;
+	if(RingCompactGetSpace(ring) < len) return NO_PLACE;
+
+	size_t elSize = arena -> elementSize;
+	uint8_t* array = RingArenaArray(arena, ring);
+	uint32_t index = ring -> writePtr & ring -> mask;
+	size_t toEnd = ring -> mask + 1 - index;
+
+	if(len > toEnd){
+		memcpy(array + index * elSize, data, toEnd * elSize);
+		memcpy(array, (const uint8_t*)data + toEnd * elSize, (len - toEnd) * elSize);
+	}else{
+		memcpy(array + index * elSize, data, len * elSize);
+	}
+	ring -> writePtr += len;
+	return OK;
+}
+
+RingStatus_t RingCompactReadElements (RingArena_t* arena, RingCompact_t* ring, void* data, size_t len){
+	if(NULL == arena) return NO_PTR;
+	if(NULL == ring) return NO_PTR;
+	if(NULL == data) return NO_PTR;
+	if(len <= 0 || 0 == ring -> mask) return NO_DATA;
+	if(RingCompactGetDataCnt(ring) < len) return NO_DATA;
+
+	size_t elSize = arena -> elementSize;
+	const uint8_t* array = RingArenaArray(arena, ring);
+	uint32_t index = ring -> readPtr & ring -> mask;
+	size_t toEnd = ring -> mask + 1 - index;
+
+	if(len > toEnd){
+		memcpy(data, array + index * elSize, toEnd * elSize);
+		memcpy((uint8_t*)data + toEnd * elSize, array, (len - toEnd) * elSize);
+	}else{
+		memcpy(data, array + index * elSize, len * elSize);
+	}
+	ring -> readPtr += len;
+	return OK;
+}
+
+/**
+ * @}
+ *
+ */
@@ -0,0 +1,225 @@
+/**
+ * @file ring_broadcast.c
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Broadcast (single producer, many consumers) ring buffer source file.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+/**
+ * @copyright GNU General Public License v3.0
+ * @{
+ */
+#include <stdint.h>
+#include <string.h>
+#include <sched.h>
+#include "ring_broadcast.h"
+
+/**< Splits count of elements starting at given pointer into array spans. */
+static inline void RingBroadcastGetSpans (RingBroadcast_t* buffer, uint32_t ptr, RingSpan_t* spans, size_t len){
+	uint32_t index = ptr & buffer -> mask;
+	size_t toEnd = buffer -> size - index;
+
+	spans[0].data = (uint8_t*)buffer -> buffer + (size_t)index * buffer -> elementSize;
+	spans[1].data = buffer -> buffer;
+	if(len > toEnd){
+		spans[0].len = toEnd;
+		spans[1].len = len - toEnd;
+	}else{
+		spans[0].len = len;
+		spans[1].len = 0;
+	}
+}
+
+/**< Finds read pointer of the slowest registered consumer. */
+static uint32_t RingBroadcastMinReadPtr (RingBroadcast_t* buffer, uint32_t head){
+	uint32_t min = head;
+
+	/* Announced before slots are loaded, so RingBroadcastUnregister either
+	 * waits for this scan or its removal is seen by it. */
+	atomic_fetch_add_explicit(&buffer -> scanners, 1, memory_order_seq_cst);
+	/* Pairs with fence in RingBroadcastRegister, so consumer being registered
+	 * either is seen here or starts at pointer not older than head. */
+	atomic_thread_fence(memory_order_seq_cst);
+	for(uint32_t i = 0; i < RING_BROADCAST_MAX_CONSUMERS; i++){
+		RingBroadcastCursor_t* cursor = atomic_load_explicit(&buffer -> consumers[i], memory_order_acquire);
+		if(cursor){
+			uint32_t tail = atomic_load_explicit(&cursor -> readPtr, memory_order_acquire);
+			if(head - tail > head - min){
+				min = tail;
+			}
+		}
+	}
+	atomic_fetch_sub_explicit(&buffer -> scanners, 1, memory_order_release);
+	return min;
+}
+
+RingStatus_t RingBroadcastInit (RingBroadcast_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize){
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == arrayBuffer) return NO_PTR;
+
+	memset(buffer, 0, sizeof(RingBroadcast_t));
+
+	if(bufferSize < 2 || (bufferSize & (bufferSize - 1)) || bufferSize > ((size_t)1 << 31)) return NO_DATA;
+	if(elementSize == 0) return NO_DATA;
+
+	buffer -> buffer = arrayBuffer;
+	buffer -> size = bufferSize;
+	buffer -> mask = bufferSize - 1;
+	buffer -> elementSize = elementSize;
+	for(uint32_t i = 0; i < RING_BROADCAST_MAX_CONSUMERS; i++){
+		atomic_init(&buffer -> consumers[i], NULL);
+	}
+	atomic_init(&buffer -> writePtr, 0);
+	buffer -> cachedMinReadPtr = 0;
+	atomic_init(&buffer -> scanners, 0);
+
+	memset(buffer -> buffer, 0, bufferSize * elementSize);
+	return OK;
+}
+
+RingStatus_t RingBroadcastRegister (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor){
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == cursor) return NO_PTR;
+	/* Second slot would keep gating producer after cursor is unregistered. */
+	for(uint32_t i = 0; i < RING_BROADCAST_MAX_CONSUMERS; i++){
+		if(cursor == atomic_load_explicit(&buffer -> consumers[i], memory_order_relaxed)) return NO_DATA;
+	}
+
+	atomic_init(&cursor -> readPtr, atomic_load_explicit(&buffer -> writePtr, memory_order_acquire));
+	for(uint32_t i = 0; i < RING_BROADCAST_MAX_CONSUMERS; i++){
+		RingBroadcastCursor_t* expected = NULL;
+		if(atomic_compare_exchange_strong(&buffer -> consumers[i], &expected, cursor)){
+			/* Producer could have checked consumers just before cursor was
+			 * added, so start from pointer it could not have overwritten. */
+			atomic_thread_fence(memory_order_seq_cst);
+			cursor -> cachedWritePtr = atomic_load_explicit(&buffer -> writePtr, memory_order_acquire);
+			atomic_store_explicit(&cursor -> readPtr, cursor -> cachedWritePtr, memory_order_release);
+			return OK;
+		}
+	}
+	return NO_PLACE;
+}
+
+RingStatus_t RingBroadcastUnregister (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor){
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == cursor) return NO_PTR;
+
+	for(uint32_t i = 0; i < RING_BROADCAST_MAX_CONSUMERS; i++){
+		RingBroadcastCursor_t* expected = cursor;
+		if(atomic_compare_exchange_strong(&buffer -> consumers[i], &expected, NULL)){
+			/* Scan which loaded cursor before it was removed may still read
+			 * it, caller is free to release cursor only after it ends. */
+			while(0 != atomic_load_explicit(&buffer -> scanners, memory_order_seq_cst)){
+				sched_yield();
+			}
+			return OK;
+		}
+	}
+	return NO_DATA;
+}
+
+uint32_t RingBroadcastGetDataCnt (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor){
+	uint32_t tail = atomic_load_explicit(&cursor -> readPtr, memory_order_acquire);
+	uint32_t head = atomic_load_explicit(&buffer -> writePtr, memory_order_acquire);
+	return head - tail;
+}
+
+uint32_t RingBroadcastGetSpace (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor){
+	uint32_t head = atomic_load_explicit(&buffer -> writePtr, memory_order_acquire);
+	if(cursor){
+		return buffer -> size - RingBroadcastGetDataCnt(buffer, cursor);
+	}
+	return buffer -> size - (head - RingBroadcastMinReadPtr(buffer, head));
+}
+
+RingStatus_t RingBroadcastWriteElement (RingBroadcast_t* buffer, const void* data){
+	return RingBroadcastWriteElements(buffer, data, 1);
+}
+
+RingStatus_t RingBroadcastWriteElements (RingBroadcast_t* buffer, const void* data, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+
+	RingSpan_t spans[2];
+	size_t elSize = buffer -> elementSize;
+	uint32_t head = atomic_load_explicit(&buffer -> writePtr, memory_order_relaxed);
+
+	if(buffer -> size - (head - buffer -> cachedMinReadPtr) < len){
+		/* Cached pointer is stale, consumers could have moved meanwhile. */
+		buffer -> cachedMinReadPtr = RingBroadcastMinReadPtr(buffer, head);
+		if(buffer -> size - (head - buffer -> cachedMinReadPtr) < len) return NO_PLACE;
+	}
+
+	RingBroadcastGetSpans(buffer, head, spans, len);
+	memcpy(spans[0].data, data, spans[0].len * elSize);
+	if(spans[1].len){
+		memcpy(spans[1].data, (const uint8_t*)data + spans[0].len * elSize, spans[1].len * elSize);
+	}
+	atomic_store_explicit(&buffer -> writePtr, head + len, memory_order_release);
+	return OK;
+}
+
+RingStatus_t RingBroadcastReadPeek (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor, RingSpan_t* spans, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(cursor == NULL) return NO_PTR;
+	if(spans == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+
+	uint32_t tail = atomic_load_explicit(&cursor -> readPtr, memory_order_relaxed);
+
+	if(cursor -> cachedWritePtr - tail < len){
+		/* Cached pointer is stale, producer could have added data meanwhile. */
+		cursor -> cachedWritePtr = atomic_load_explicit(&buffer -> writePtr, memory_order_acquire);
+		if(cursor -> cachedWritePtr - tail < len) return NO_DATA;
+	}
+
+	RingBroadcastGetSpans(buffer, tail, spans, len);
+	return OK;
+}
+
+RingStatus_t RingBroadcastReadConsume (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(cursor == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+
+	uint32_t tail = atomic_load_explicit(&cursor -> readPtr, memory_order_relaxed);
+
+	if(cursor -> cachedWritePtr - tail < len){
+		cursor -> cachedWritePtr = atomic_load_explicit(&buffer -> writePtr, memory_order_acquire);
+		if(cursor -> cachedWritePtr - tail < len) return NO_DATA;
+	}
+	atomic_store_explicit(&cursor -> readPtr, tail + len, memory_order_release);
+	return OK;
+}
+
+RingStatus_t RingBroadcastReadElement (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor, void* data){
+	return RingBroadcastReadElements(buffer, cursor, data, 1);
+}
+
+RingStatus_t RingBroadcastReadElements (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor, void* data, size_t len){
+	RingSpan_t spans[2];
+	RingStatus_t retval;
+
+	if(data == NULL) return NO_PTR;
+	retval = RingBroadcastReadPeek(buffer, cursor, spans, len);
+	if(OK != retval) return retval;
+
+	size_t elSize = buffer -> elementSize;
+	memcpy(data, spans[0].data, spans[0].len * elSize);
+	if(spans[1].len){
+		memcpy((uint8_t*)data + spans[0].len * elSize, spans[1].data, spans[1].len * elSize);
+	}
+	return RingBroadcastReadConsume(buffer, cursor, len);
+}
+
+/**
+ * @}
+ *
+ */
@@ -0,0 +1,360 @@
+/**
+ * @file ring_coro.hpp
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Header-only C++20 coroutine adapters for C ring buffer.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ */
+
+#ifndef RING_CORO_HPP_
+#define RING_CORO_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "ring.h"
+
+/**
+ * @defgroup Ring_Buffer_Coro
+ * @brief Awaitable reads and writes of RingBuffer_t.
+ *
+ * Coroutine which can not read (or write) at once is parked in intrusive
+ * waiter list of adapter, its awaiter object living in coroutine frame is the
+ * list node, so no memory is allocated per await. Operation which frees place
+ * (or adds data) completes transfers of parked coroutines on the other side
+ * in order and posts them to executor. Everything runs on one thread.
+ * @{
+ */
+
+/**
+ * @brief Node of intrusive list of suspended coroutines.
+ *
+ */
+struct RingWaiter{
+	RingWaiter* next = nullptr; /**< Next node in list. */
+	std::coroutine_handle<> handle; /**< Coroutine to resume. */
+};
+
+/**
+ * @brief FIFO list of waiters, nodes are owned by their coroutines.
+ *
+ */
+class RingWaiterList{
+public:
+	bool empty() const noexcept{
+		return nullptr == head;
+	}
+
+	RingWaiter* front() const noexcept{
+		return head;
+	}
+
+	void push(RingWaiter* waiter) noexcept{
+		waiter->next = nullptr;
+		if(tail){
+			tail->next = waiter;
+		}else{
+			head = waiter;
+		}
+		tail = waiter;
+	}
+
+	RingWaiter* pop() noexcept{
+		RingWaiter* waiter = head;
+		head = waiter->next;
+		if(nullptr == head){
+			tail = nullptr;
+		}
+		return waiter;
+	}
+
+private:
+	RingWaiter* head = nullptr;
+	RingWaiter* tail = nullptr;
+};
+
+class RingExecutor;
+
+/**
+ * @brief Fire-and-forget coroutine, started and owned by RingExecutor.
+ *
+ */
+class RingTask{
+public:
+	struct promise_type : RingWaiter{
+		RingTask get_return_object() noexcept{
+			return RingTask(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		std::suspend_always initial_suspend() noexcept{
+			return {};
+		}
+		std::suspend_always final_suspend() noexcept{
+			return {};
+		}
+		void return_void() noexcept{
+		}
+		void unhandled_exception() noexcept{
+			std::terminate();
+		}
+	};
+
+	RingTask(RingTask&& other) noexcept : coro(std::exchange(other.coro, nullptr)){
+	}
+
+	RingTask(const RingTask&) = delete;
+	RingTask& operator=(const RingTask&) = delete;
+
+	~RingTask(){
+		if(coro){
+			coro.destroy();
+		}
+	}
+
+private:
+	friend class RingExecutor;
+
+	explicit RingTask(std::coroutine_handle<promise_type> handle) noexcept : coro(handle){
+	}
+
+	std::coroutine_handle<promise_type> coro;
+};
+
+/**
+ * @brief Single-threaded executor, resumes posted coroutines in order.
+ *
+ */
+class RingExecutor{
+public:
+	RingExecutor() noexcept = default;
+
+	RingExecutor(const RingExecutor&) = delete;
+	RingExecutor& operator=(const RingExecutor&) = delete;
+
+	/**
+	 * @brief Destroys frames of coroutines which were queued but not run.
+	 *
+	 */
+	~RingExecutor(){
+		while(!ready.empty()){
+			ready.pop()->handle.destroy();
+		}
+	}
+
+	/**
+	 * @brief Takes ownership of task and queues its start.
+	 *
+	 * @param task Task which was not started yet.
+	 */
+	void spawn(RingTask task) noexcept{
+		auto handle = std::exchange(task.coro, nullptr);
+		handle.promise().handle = handle;
+		post(handle.promise());
+	}
+
+	/**
+	 * @brief Queues waiter for resumption.
+	 *
+	 * @param waiter Node of suspended coroutine.
+	 */
+	void post(RingWaiter& waiter) noexcept{
+		ready.push(&waiter);
+	}
+
+	/**
+	 * @brief Resumes queued coroutines until none is ready. Frames of
+	 * finished tasks are destroyed. Tasks parked on a ring stay suspended.
+	 *
+	 * @return std::size_t Count of resumptions.
+	 */
+	std::size_t run(){
+		std::size_t count = 0;
+		while(!ready.empty()){
+			std::coroutine_handle<> handle = ready.pop()->handle;
+			handle.resume();
+			if(handle.done()){
+				handle.destroy();
+			}
+			count++;
+		}
+		return count;
+	}
+
+private:
+	RingWaiterList ready; /**< Coroutines ready to run. */
+};
+
+/**
+ * @brief Awaitable adapter of C ring buffer holding elements of type T.
+ *
+ * Reads and writes are all-or-nothing, as RingReadElements and
+ * RingWriteElements, and are completed in the order they were awaited.
+ * Buffer must be accessed only through adapter while coroutines wait on it.
+ *
+ * @tparam T Trivially copyable element type, of buffer's element size.
+ */
+template <typename T>
+class RingAsync{
+	static_assert(std::is_trivially_copyable<T>::value, "Ring elements are copied with memcpy");
+
+public:
+	/**
+	 * @brief Awaiter of one read or write, list node while suspended.
+	 *
+	 */
+	class Awaiter : public RingWaiter{
+	public:
+		/**
+		 * @brief Completes operation at once if nobody waits before it, or
+		 * if it fails for other reason than lack of data or place.
+		 */
+		bool await_ready() noexcept{
+			if(len > owner.capacity()){
+				/* Could never complete. */
+				status = write ? NO_PLACE : NO_DATA;
+				return true;
+			}
+			RingWaiterList& waiters = write ? owner.writers : owner.readers;
+			if(!waiters.empty()){
+				return false;
+			}
+			status = owner.transfer(*this);
+			if(OK == status){
+				owner.service();
+				return true;
+			}
+			return !blocked();
+		}
+
+		void await_suspend(std::coroutine_handle<> coroutine) noexcept{
+			handle = coroutine;
+			(write ? owner.writers : owner.readers).push(this);
+		}
+
+		/**
+		 * @return RingStatus_t OK, NO_DATA / NO_PLACE if count of
+		 * elements exceeds buffer capacity, or other error of transfer.
+		 */
+		RingStatus_t await_resume() const noexcept{
+			return status;
+		}
+
+	private:
+		friend class RingAsync;
+
+		/**< Transfer failed only because it has to wait for other side. */
+		bool blocked() const noexcept{
+			return status == (write ? NO_PLACE : NO_DATA);
+		}
+
+		Awaiter(RingAsync& adapter, void* buffer, std::size_t count, bool isWrite) noexcept :
+			owner(adapter), data(buffer), len(count), write(isWrite){
+		}
+
+		RingAsync& owner;
+		void* data; /**< Elements to write, or place to read them to. */
+		std::size_t len; /**< Count of elements. */
+		bool write; /**< Write, otherwise read. */
+		RingStatus_t status = NO_DATA;
+	};
+
+	RingAsync(RingBuffer_t& buffer, RingExecutor& executor) noexcept : ring(buffer), exec(executor){
+	}
+
+	RingAsync(const RingAsync&) = delete;
+	RingAsync& operator=(const RingAsync&) = delete;
+
+	/**
+	 * @brief Destroys frames of coroutines still parked on adapter, as
+	 * they could never be resumed.
+	 *
+	 */
+	~RingAsync(){
+		while(!readers.empty()){
+			readers.pop()->handle.destroy();
+		}
+		while(!writers.empty()){
+			writers.pop()->handle.destroy();
+		}
+	}
+
+	/**
+	 * @brief Reads data.size() elements, suspending until they are available.
+	 *
+	 * @param data Place for elements, must live until await completes.
+	 * @return Awaiter Yields RingStatus_t.
+	 */
+	Awaiter read(std::span<T> data) noexcept{
+		return Awaiter(*this, data.data(), data.size(), false);
+	}
+
+	/**
+	 * @brief Writes data.size() elements, suspending until there is place.
+	 *
+	 * @param data Elements to write, must live until await completes.
+	 * @return Awaiter Yields RingStatus_t.
+	 */
+	Awaiter write(std::span<const T> data) noexcept{
+		return Awaiter(*this, const_cast<T*>(data.data()), data.size(), true);
+	}
+
+	/**
+	 * @brief Returns count of elements buffer can hold.
+	 *
+	 * @return std::size_t Capacity given in elements.
+	 */
+	std::size_t capacity() const noexcept{
+		return RingGetSpace(&ring) + RingGetDataCnt(&ring);
+	}
+
+private:
+	RingStatus_t transfer(Awaiter& op) noexcept{
+		if(op.write){
+			return RingWriteElements(&ring, op.data, op.len);
+		}
+		return RingReadElements(&ring, op.data, op.len);
+	}
+
+	/**< Completes parked operations of both sides while possible. Every
+	 * read frees place for writers, every write adds data for readers. */
+	void service() noexcept{
+		bool progress = true;
+		while(progress){
+			progress = servicePending(readers) | servicePending(writers);
+		}
+	}
+
+	/**< Completes parked operations of one side in order, until one has
+	 * to keep waiting. Failed operations are completed with their error. */
+	bool servicePending(RingWaiterList& waiters) noexcept{
+		bool progress = false;
+		while(!waiters.empty()){
+			Awaiter* op = static_cast<Awaiter*>(waiters.front());
+			op->status = transfer(*op);
+			if(op->blocked()){
+				break;
+			}
+			waiters.pop();
+			exec.post(*op);
+			progress = true;
+		}
+		return progress;
+	}
+
+	RingBuffer_t& ring;
+	RingExecutor& exec;
+	RingWaiterList readers; /**< Coroutines waiting for data. */
+	RingWaiterList writers; /**< Coroutines waiting for place. */
+};
+
+/**
+ * @}
+ *
+ */
+#endif /* RING_CORO_HPP_ */
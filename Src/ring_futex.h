@@ -0,0 +1,58 @@
+/**
+ * @file ring_futex.h
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Internal futex helpers shared by blocking buffer variants.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ */
+
+#ifndef RING_FUTEX_H_
+#define RING_FUTEX_H_
+
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <sched.h>
+#include <stdatomic.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+/**< Sleeps while futex word equals given value, at most timeoutNs (if >= 0). */
+static inline void RingFutexWait (atomic_uint_least32_t* word, uint32_t value, int64_t timeoutNs){
+#ifdef __linux__
+	struct timespec ts;
+	ts.tv_sec = timeoutNs / 1000000000;
+	ts.tv_nsec = timeoutNs % 1000000000;
+	syscall(SYS_futex, (uint32_t*)word, FUTEX_WAIT_PRIVATE, value, timeoutNs >= 0 ? &ts : NULL, NULL, 0);
+#else
+	(void)word;
+	(void)value;
+	(void)timeoutNs;
+	sched_yield();
+#endif
+}
+
+/**< Wakes all threads sleeping on futex word. */
+static inline void RingFutexWake (atomic_uint_least32_t* word){
+#ifdef __linux__
+	syscall(SYS_futex, (uint32_t*)word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#else
+	(void)word;
+#endif
+}
+
+/**< Monotonic time given in nanoseconds. */
+static inline int64_t RingNowNs (void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+#endif /* RING_FUTEX_H_ */
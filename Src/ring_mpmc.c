@@ -0,0 +1,183 @@
+/**
+ * @file ring_mpmc.c
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Lock-free multi-producer/multi-consumer ring buffer source file.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+/**
+ * @copyright GNU General Public License v3.0
+ * @{
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ring_mpmc.h"
+
+/**< Sequence number of slot. Equal to position when slot is free for that
+ * position, position + 1 when it holds data written at that position. */
+static inline atomic_uint_least32_t* RingMpmcSeq (RingMpmc_t* buffer, uint32_t pos){
+	return (atomic_uint_least32_t*)((uint8_t*)buffer -> buffer + (size_t)(pos & buffer -> mask) * buffer -> slotSize);
+}
+
+/**< Element storage of slot. */
+static inline uint8_t* RingMpmcData (RingMpmc_t* buffer, uint32_t pos){
+	return (uint8_t*)RingMpmcSeq(buffer, pos) + sizeof(uint32_t);
+}
+
+RingStatus_t RingMpmcInit (RingMpmc_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize){
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == arrayBuffer) return NO_PTR;
+
+	memset(buffer, 0, sizeof(RingMpmc_t));
+
+	if(bufferSize < 2 || (bufferSize & (bufferSize - 1)) || bufferSize > ((size_t)1 << 31)) return NO_DATA;
+	if(elementSize == 0) return NO_DATA;
+
+	buffer -> buffer = arrayBuffer;
+	buffer -> size = bufferSize;
+	buffer -> mask = bufferSize - 1;
+	buffer -> elementSize = elementSize;
+	buffer -> slotSize = RING_MPMC_SLOT_SIZE(elementSize);
+	atomic_init(&buffer -> writePtr, 0);
+	atomic_init(&buffer -> readPtr, 0);
+
+	memset(buffer -> buffer, 0, bufferSize * buffer -> slotSize);
+	for(uint32_t i = 0; i < bufferSize; i++){
+		atomic_init(RingMpmcSeq(buffer, i), i);
+	}
+	return OK;
+}
+
+RingStatus_t RingMpmcInitAlloc (RingMpmc_t* buffer, size_t bufferSize, size_t elementSize){
+	void* ptr;
+	RingStatus_t retval;
+	if(NULL == buffer){
+		return NO_PTR;
+	}
+	ptr = malloc(RING_MPMC_ARRAY_SIZE(bufferSize, elementSize));
+	if(NULL == ptr){
+		return NO_PTR;
+	}
+	retval = RingMpmcInit(buffer, ptr, bufferSize, elementSize);
+	if(OK == retval){
+		buffer -> allocated = 1;
+	}else{
+		free(ptr);
+	}
+	return retval;
+}
+
+RingStatus_t RingMpmcFree (RingMpmc_t* buffer){
+	if(NULL == buffer) return NO_PTR;
+	if(buffer -> allocated){
+		free(buffer -> buffer);
+	}
+	memset(buffer, 0, sizeof(RingMpmc_t));
+	return OK;
+}
+
+uint32_t RingMpmcGetDataCnt (RingMpmc_t* buffer){
+	uint32_t tail = atomic_load_explicit(&buffer -> readPtr, memory_order_acquire);
+	uint32_t head = atomic_load_explicit(&buffer -> writePtr, memory_order_acquire);
+	int32_t cnt = (int32_t)(head - tail);
+	/* Pointers are loaded one after another, snapshot can be out of range. */
+	if(cnt < 0) return 0;
+	if((uint32_t)cnt > buffer -> size) return buffer -> size;
+	return cnt;
+}
+
+uint32_t RingMpmcGetSpace (RingMpmc_t* buffer){
+	return buffer -> size - RingMpmcGetDataCnt(buffer);
+}
+
+/**< Claims len consecutive positions from given pointer with one CAS.
+ * Slot at position pos + i is ready when its sequence equals pos + i + offset.
+ * Returns claimed start position in pos, or 0 if slots are not ready. */
+static int RingMpmcClaim (RingMpmc_t* buffer, atomic_uint_least32_t* ptr, uint32_t offset, uint32_t len, uint32_t* pos){
+	uint32_t start = atomic_load_explicit(ptr, memory_order_relaxed);
+
+	for(;;){
+		uint32_t i;
+		int stale = 0;
+
+		for(i = 0; i < len; i++){
+			uint32_t seq = atomic_load_explicit(RingMpmcSeq(buffer, start + i), memory_order_acquire);
+			int32_t dif = (int32_t)(seq - (start + i + offset));
+			if(dif < 0){
+				/* Slot still used by previous lap. */
+				return 0;
+			}
+			if(dif > 0){
+				/* Other thread claimed this position already. */
+				stale = 1;
+				break;
+			}
+		}
+
+		if(stale){
+			start = atomic_load_explicit(ptr, memory_order_relaxed);
+		}else if(atomic_compare_exchange_weak_explicit(ptr, &start, start + len,
+				memory_order_relaxed, memory_order_relaxed)){
+			*pos = start;
+			return 1;
+		}
+	}
+}
+
+RingStatus_t RingMpmcWriteElement (RingMpmc_t* buffer, const void* data){
+	return RingMpmcWriteElements(buffer, data, 1);
+}
+
+RingStatus_t RingMpmcWriteElements (RingMpmc_t* buffer, const void* data, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+	if(len > buffer -> size) return NO_PLACE;
+
+	uint32_t pos;
+	size_t elSize = buffer -> elementSize;
+
+	if(!RingMpmcClaim(buffer, &buffer -> writePtr, 0, len, &pos)) return NO_PLACE;
+
+	for(uint32_t i = 0; i < len; i++){
+		memcpy(RingMpmcData(buffer, pos + i), (const uint8_t*)data + i * elSize, elSize);
+		atomic_store_explicit(RingMpmcSeq(buffer, pos + i), pos + i + 1, memory_order_release);
+	}
+	return OK;
+}
+
+RingStatus_t RingMpmcReadElement (RingMpmc_t* buffer, void* data){
+	return RingMpmcReadElements(buffer, data, 1);
+}
+
+RingStatus_t RingMpmcReadElements (RingMpmc_t* buffer, void* data, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+	if(len > buffer -> size) return NO_DATA;
+
+	uint32_t pos;
+	size_t elSize = buffer -> elementSize;
+
+	if(!RingMpmcClaim(buffer, &buffer -> readPtr, 1, len, &pos)) return NO_DATA;
+
+	for(uint32_t i = 0; i < len; i++){
+		memcpy((uint8_t*)data + i * elSize, RingMpmcData(buffer, pos + i), elSize);
+		/* Free slot for the producer of the next lap. */
+		atomic_store_explicit(RingMpmcSeq(buffer, pos + i), pos + i + buffer -> size, memory_order_release);
+	}
+	return OK;
+}
+
+/**
+ * @}
+ *
+ */
@@ -0,0 +1,147 @@
+/**
+ * @file ring_mpmc.h
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Lock-free multi-producer/multi-consumer ring buffer header.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ */
+
+#ifndef RING_MPMC_H_
+#define RING_MPMC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include "ring.h"
+
+/**
+ * @defgroup Ring_Buffer_Mpmc
+ * @brief Lock-free MPMC variant of the FIFO ring buffer.
+ *
+ * Bounded queue of fixed size elements with sequence number in every slot
+ * (D. Vyukov's design). Any number of threads may write and read at the same
+ * time. Multiple elements functions claim all their slots with one atomic
+ * operation.
+ * @{
+ */
+
+/**< Size of one slot (sequence number and element) given in bytes. */
+#define RING_MPMC_SLOT_SIZE(elementSize) \
+	((sizeof(uint32_t) + (elementSize) + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1))
+
+/**< Size of array required by RingMpmcInit, given in bytes. */
+#define RING_MPMC_ARRAY_SIZE(bufferSize, elementSize) \
+	((bufferSize) * RING_MPMC_SLOT_SIZE(elementSize))
+
+/**
+ * @brief MPMC buffer handler structure.
+ *
+ */
+typedef struct{
+	alignas(RING_CACHE_LINE) size_t size; /**< Size of buffer given in elements. */
+	size_t elementSize; /**< Size of one buffer element. */
+	size_t slotSize; /**< Size of one slot given in bytes. */
+	uint32_t mask; /**< Index mask, size - 1. */
+	uint32_t allocated; /**< Array was allocated by RingMpmcInitAlloc. */
+	void* buffer; /**< Pointer to array holding slots. */
+
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t writePtr; /**< Next position to claim by producers. */
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t readPtr; /**< Next position to claim by consumers. */
+} RingMpmc_t;
+
+/**
+ * @brief Function to initialize MPMC ring buffer.
+ *
+ * @param buffer Pointer to buffer structure that has to be initialized.
+ * @param arrayBuffer Pointer to array of RING_MPMC_ARRAY_SIZE bytes,
+ * aligned at least to 4 bytes.
+ * @param bufferSize Size of buffer given in elements, power of two, at least 2.
+ * @param elementSize Size of one element
+ * @return RingStatus_t NO_DATA if bufferSize is not a power of two.
+ */
+RingStatus_t RingMpmcInit (RingMpmc_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize);
+
+/**
+ * @brief Function to initialize MPMC ring buffer with memory allocation.
+ *
+ * @param buffer Pointer to buffer structure that has to be initialized.
+ * @param bufferSize Size of buffer given in elements, power of two, at least 2.
+ * @param elementSize Size of one element
+ * @return RingStatus_t
+ */
+RingStatus_t RingMpmcInitAlloc (RingMpmc_t* buffer, size_t bufferSize, size_t elementSize);
+
+/**
+ * @brief Releases memory of buffer initialized with RingMpmcInitAlloc.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return RingStatus_t
+ */
+RingStatus_t RingMpmcFree (RingMpmc_t* buffer);
+
+/**
+ * @brief Function that returns count of data available in buffer.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return uint32_t Snapshot of data count in buffer given in elements.
+ */
+uint32_t RingMpmcGetDataCnt (RingMpmc_t* buffer);
+
+/**
+ * @brief Function that returns available space in selected buffer.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return uint32_t Snapshot of available space given in elements.
+ */
+uint32_t RingMpmcGetSpace (RingMpmc_t* buffer);
+
+/**
+ * @brief Adds one element to the end of buffer.
+ *
+ * @param buffer Pointer to buffer to write.
+ * @param data Data to write.
+ * @return RingStatus_t Status of write process.
+ */
+RingStatus_t RingMpmcWriteElement (RingMpmc_t* buffer, const void* data);
+
+/**
+ * @brief Writes multiple elements to buffer, as one continuous block.
+ *
+ * Elements from one call are never interleaved with elements of other producers.
+ *
+ * @param buffer Buffer to write data.
+ * @param data Data pointer to write.
+ * @param len Count of elements to write.
+ * @return RingStatus_t NO_PLACE if len elements could not be claimed at once.
+ */
+RingStatus_t RingMpmcWriteElements (RingMpmc_t* buffer, const void* data, size_t len);
+
+/**
+ * @brief Reads one element from buffer.
+ *
+ * @param buffer Buffer to read.
+ * @param data Pointer to save data.
+ * @return RingStatus_t Read status.
+ */
+RingStatus_t RingMpmcReadElement (RingMpmc_t* buffer, void* data);
+
+/**
+ * @brief Reads multiple consecutive elements from buffer.
+ *
+ * @param buffer Buffer to read data.
+ * @param data Pointer to write data.
+ * @param len Count of elements to read.
+ * @return RingStatus_t NO_DATA if len elements could not be claimed at once.
+ */
+RingStatus_t RingMpmcReadElements (RingMpmc_t* buffer, void* data, size_t len);
+
+/**
+ * @}
+ *
+ */
+#endif /* RING_MPMC_H_ */
@@ -0,0 +1,231 @@
+/**
+ * @file ring_set.c
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Readiness set of SPSC ring buffers source file.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+/**
+ * @copyright GNU General Public License v3.0
+ * @{
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ring_set.h"
+#include "ring_futex.h"
+
+/**< Count of summary words for given capacity. */
+static inline size_t RingSetSummaryWords (size_t capacity){
+	size_t words = capacity / RING_SET_WORD_BITS;
+	return (words + RING_SET_WORD_BITS - 1) / RING_SET_WORD_BITS;
+}
+
+/**< Sets slot bit, and summary bit if its word was zero. Returns 1 if slot bit was clear. */
+static inline int RingSetSetBit (RingSet_t* set, size_t index){
+	size_t word = index / RING_SET_WORD_BITS;
+	uint64_t bit = (uint64_t)1 << (index % RING_SET_WORD_BITS);
+	uint64_t old = atomic_fetch_or(&set -> ready[word], bit);
+
+	if(0 == old){
+		atomic_fetch_or(&set -> summary[word / RING_SET_WORD_BITS], (uint64_t)1 << (word % RING_SET_WORD_BITS));
+	}
+	return 0 == (old & bit);
+}
+
+RingStatus_t RingSetInitAlloc (RingSet_t* set, size_t capacity){
+	if(NULL == set) return NO_PTR;
+	memset(set, 0, sizeof(RingSet_t));
+	if(0 == capacity) return NO_DATA;
+
+	capacity = (capacity + RING_SET_WORD_BITS - 1) / RING_SET_WORD_BITS * RING_SET_WORD_BITS;
+	set -> rings = calloc(capacity, sizeof(RingSpsc_t*));
+	set -> ready = calloc(capacity / RING_SET_WORD_BITS, sizeof(atomic_uint_least64_t));
+	set -> summary = calloc(RingSetSummaryWords(capacity), sizeof(atomic_uint_least64_t));
+	if(NULL == set -> rings || NULL == set -> ready || NULL == set -> summary){
+		RingSetFree(set);
+		return NO_PTR;
+	}
+	set -> capacity = capacity;
+	atomic_init(&set -> seq, 0);
+	atomic_init(&set -> waiters, 0);
+	return OK;
+}
+
+RingStatus_t RingSetFree (RingSet_t* set){
+	if(NULL == set) return NO_PTR;
+	for(size_t i = 0; i < set -> capacity; i++){
+		if(NULL != set -> rings[i]){
+			set -> rings[i] -> set = NULL;
+		}
+	}
+	free(set -> rings);
+	free((void*)set -> ready);
+	free((void*)set -> summary);
+	memset(set, 0, sizeof(RingSet_t));
+	return OK;
+}
+
+RingStatus_t RingSetAdd (RingSet_t* set, RingSpsc_t* ring){
+	if(NULL == set) return NO_PTR;
+	if(NULL == ring) return NO_PTR;
+	if(NULL != ring -> set) return NO_DATA;
+	if(set -> count == set -> capacity) return NO_PLACE;
+
+	/* Registration is rare compared to polling, linear search is enough. */
+	size_t index = 0;
+	while(NULL != set -> rings[index]){
+		index++;
+	}
+	set -> rings[index] = ring;
+	set -> count++;
+	ring -> setIndex = index;
+	ring -> set = set;
+	if(RingSpscGetDataCnt(ring)){
+		RingSetMark(set, index);
+	}
+	return OK;
+}
+
+RingStatus_t RingSetRemove (RingSet_t* set, RingSpsc_t* ring){
+	if(NULL == set) return NO_PTR;
+	if(NULL == ring) return NO_PTR;
+	if(set != ring -> set) return NO_DATA;
+
+	size_t index = ring -> setIndex;
+	atomic_fetch_and(&set -> ready[index / RING_SET_WORD_BITS], ~((uint64_t)1 << (index % RING_SET_WORD_BITS)));
+	set -> rings[index] = NULL;
+	set -> count--;
+	ring -> set = NULL;
+	return OK;
+}
+
+void RingSetMark (RingSet_t* set, uint32_t index){
+	if(RingSetSetBit(set, index)){
+		/* Pairs with fence in RingSetWait: either consumer sees this bit,
+		 * or this check sees the consumer waiting. */
+		atomic_thread_fence(memory_order_seq_cst);
+		if(atomic_load_explicit(&set -> waiters, memory_order_relaxed)){
+			atomic_fetch_add_explicit(&set -> seq, 1, memory_order_release);
+			RingFutexWake(&set -> seq);
+		}
+	}
+}
+
+/**< Clears slot bit, then returns buffer if it still has data (bit is set back then). */
+static RingSpsc_t* RingSetCheck (RingSet_t* set, size_t index){
+	RingSpsc_t* ring = set -> rings[index];
+
+	atomic_fetch_and(&set -> ready[index / RING_SET_WORD_BITS], ~((uint64_t)1 << (index % RING_SET_WORD_BITS)));
+	/* Pairs with fence in RingSpscWriteElements: either producer sees read
+	 * index of drained buffer and marks it again, or data count below sees
+	 * its write index. */
+	atomic_thread_fence(memory_order_seq_cst);
+	if(NULL == ring || 0 == RingSpscGetDataCnt(ring)) return NULL;
+	RingSetSetBit(set, index);
+	return ring;
+}
+
+/**< Finds first buffer with data in slots from given one to the end. */
+static RingSpsc_t* RingSetScan (RingSet_t* set, size_t from){
+	size_t firstWord = from / RING_SET_WORD_BITS;
+	size_t summaryWords = RingSetSummaryWords(set -> capacity);
+
+	for(size_t s = firstWord / RING_SET_WORD_BITS; s < summaryWords; s++){
+		uint64_t words = atomic_load_explicit(&set -> summary[s], memory_order_acquire);
+		if(s == firstWord / RING_SET_WORD_BITS){
+			words &= ~(uint64_t)0 << (firstWord % RING_SET_WORD_BITS);
+		}
+		while(words){
+			size_t w = s * RING_SET_WORD_BITS + __builtin_ctzll(words);
+			words &= words - 1;
+
+			uint64_t bits = atomic_load_explicit(&set -> ready[w], memory_order_acquire);
+			if(w == firstWord){
+				bits &= ~(uint64_t)0 << (from % RING_SET_WORD_BITS);
+			}
+			while(bits){
+				size_t index = w * RING_SET_WORD_BITS + __builtin_ctzll(bits);
+				bits &= bits - 1;
+				RingSpsc_t* ring = RingSetCheck(set, index);
+				if(NULL != ring){
+					set -> cursor = (index + 1 == set -> capacity) ? 0 : index + 1;
+					return ring;
+				}
+			}
+
+			if(0 == atomic_load(&set -> ready[w])){
+				uint64_t bit = (uint64_t)1 << (w % RING_SET_WORD_BITS);
+				atomic_fetch_and(&set -> summary[s], ~bit);
+				/* Producer could mark slot of this word meanwhile and see its
+				 * summary bit still set, so word is checked again. */
+				if(0 != atomic_load(&set -> ready[w])){
+					atomic_fetch_or(&set -> summary[s], bit);
+				}
+			}
+		}
+	}
+	return NULL;
+}
+
+RingSpsc_t* RingSetNextReady (RingSet_t* set){
+	RingSpsc_t* ring;
+
+	if(NULL == set) return NULL;
+	if(0 == set -> count) return NULL;
+
+	ring = RingSetScan(set, set -> cursor);
+	if(NULL == ring && 0 != set -> cursor){
+		ring = RingSetScan(set, 0);
+	}
+	return ring;
+}
+
+/**< Returns 1 if any slot may be ready. */
+static inline int RingSetAnyReady (RingSet_t* set){
+	size_t summaryWords = RingSetSummaryWords(set -> capacity);
+	for(size_t s = 0; s < summaryWords; s++){
+		if(atomic_load(&set -> summary[s])) return 1;
+	}
+	return 0;
+}
+
+RingStatus_t RingSetWait (RingSet_t* set, uint32_t timeoutUs){
+	int64_t deadline = 0;
+
+	if(NULL == set) return NO_PTR;
+	if(RingSetAnyReady(set)) return OK;
+	if(RING_WAIT_FOREVER != timeoutUs){
+		deadline = RingNowNs() + (int64_t)timeoutUs * 1000;
+	}
+
+	for(;;){
+		int64_t remaining = -1;
+		if(RING_WAIT_FOREVER != timeoutUs){
+			remaining = deadline - RingNowNs();
+			if(remaining <= 0) return NO_DATA;
+		}
+
+		atomic_fetch_add_explicit(&set -> waiters, 1, memory_order_relaxed);
+		/* Pairs with fence in RingSetMark. */
+		atomic_thread_fence(memory_order_seq_cst);
+		uint32_t value = atomic_load_explicit(&set -> seq, memory_order_acquire);
+		int ready = RingSetAnyReady(set);
+		if(!ready){
+			RingFutexWait(&set -> seq, value, remaining);
+			ready = RingSetAnyReady(set);
+		}
+		atomic_fetch_sub_explicit(&set -> waiters, 1, memory_order_relaxed);
+		if(ready) return OK;
+	}
+}
+
+/**
+ * @}
+ *
+ */
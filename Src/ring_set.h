@@ -0,0 +1,132 @@
+/**
+ * @file ring_set.h
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Readiness set of SPSC ring buffers header.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ */
+
+#ifndef RING_SET_H_
+#define RING_SET_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include "ring.h"
+#include "ring_spsc.h"
+
+/**
+ * @defgroup Ring_Buffer_Set
+ * @brief Set of SPSC buffers polled by one consumer thread.
+ *
+ * Every registered buffer has one bit in readiness bitmap, which producer
+ * sets when buffer goes from empty to non-empty. Second level bitmap has one
+ * bit per non-zero bitmap word, so finding ready buffers costs time
+ * proportional to count of buffers with data, not to count of registered ones.
+ * Producers may run in any threads, all set functions except RingSetMark are
+ * called by one consumer thread, which is also the only reader of buffers.
+ * @{
+ */
+
+/**< Count of slots described by one bitmap word. */
+#define RING_SET_WORD_BITS 64
+
+/**
+ * @brief Readiness set handler structure.
+ *
+ */
+typedef struct RingSet_s{
+	size_t capacity; /**< Count of slots, multiple of RING_SET_WORD_BITS. */
+	size_t count; /**< Count of registered buffers. */
+	size_t cursor; /**< Slot next scan starts at, so busy buffers do not starve other ones. */
+	RingSpsc_t** rings; /**< Registered buffers, NULL in free slots. */
+	atomic_uint_least64_t* ready; /**< One bit per slot, set if buffer may have data. */
+	atomic_uint_least64_t* summary; /**< One bit per word of ready, set if that word may be non-zero. */
+
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t seq; /**< Futex word consumer parks on, bumped on wake-up. */
+	atomic_uint_least32_t waiters; /**< Count of consumers parked in RingSetWait. */
+} RingSet_t;
+
+/**
+ * @brief Allocates set for given count of buffers.
+ *
+ * @param set Pointer to set structure that has to be initialized.
+ * @param capacity Maximum count of buffers, rounded up to RING_SET_WORD_BITS.
+ * @return RingStatus_t NO_PTR if allocation failed, NO_DATA if capacity is 0.
+ */
+RingStatus_t RingSetInitAlloc (RingSet_t* set, size_t capacity);
+
+/**
+ * @brief Releases memory of set. Buffers have to be removed before, or
+ * not written anymore.
+ *
+ * @param set Pointer to set structure.
+ * @return RingStatus_t
+ */
+RingStatus_t RingSetFree (RingSet_t* set);
+
+/**
+ * @brief Registers buffer in set.
+ *
+ * Has to be called while producer of buffer does not write to it, e.g. before
+ * its thread is started. Buffer with data is reported ready at once.
+ *
+ * @param set Pointer to set structure.
+ * @param ring Buffer to register, not registered in any set.
+ * @return RingStatus_t NO_PLACE if all slots are used, NO_DATA if buffer is
+ * already registered.
+ */
+RingStatus_t RingSetAdd (RingSet_t* set, RingSpsc_t* ring);
+
+/**
+ * @brief Removes buffer from set.
+ *
+ * Has to be called while producer of buffer does not write to it.
+ *
+ * @param set Pointer to set structure.
+ * @param ring Buffer registered in this set.
+ * @return RingStatus_t NO_DATA if buffer is not registered in this set.
+ */
+RingStatus_t RingSetRemove (RingSet_t* set, RingSpsc_t* ring);
+
+/**
+ * @brief Returns next buffer with data, scanning round-robin from the last one.
+ *
+ * Buffer stays marked ready until it is found empty, so consumer does not
+ * have to drain it at once. Stale bits of drained buffers are cleared on the way.
+ *
+ * @param set Pointer to set structure.
+ * @return RingSpsc_t* Buffer with data, or NULL if no buffer has data.
+ */
+RingSpsc_t* RingSetNextReady (RingSet_t* set);
+
+/**
+ * @brief Waits until any buffer in set may have data.
+ *
+ * May return OK spuriously, RingSetNextReady tells if there really is data.
+ *
+ * @param set Pointer to set structure.
+ * @param timeoutUs Timeout given in microseconds, or RING_WAIT_FOREVER.
+ * @return RingStatus_t NO_DATA if nothing was marked ready until timeout.
+ */
+RingStatus_t RingSetWait (RingSet_t* set, uint32_t timeoutUs);
+
+/**
+ * @brief Marks slot ready and wakes parked consumer. Called by
+ * RingSpscWriteElements on empty to non-empty transition of registered buffer.
+ *
+ * @param set Pointer to set structure.
+ * @param index Slot of buffer.
+ */
+void RingSetMark (RingSet_t* set, uint32_t index);
+
+/**
+ * @}
+ *
+ */
+#endif /* RING_SET_H_ */
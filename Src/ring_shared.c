@@ -0,0 +1,480 @@
+/**
+ * @file ring_shared.c
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Cross-process shared memory ring buffer source file.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+/**
+ * @copyright GNU General Public License v3.0
+ * @{
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#ifdef __unix__
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "ring_shared.h"
+
+/**< Offset of buffer array, control block rounded up to cache line. */
+#define RING_SHARED_DATA_OFFSET \
+	((sizeof(RingSharedHeader_t) + RING_CACHE_LINE - 1) / RING_CACHE_LINE * RING_CACHE_LINE)
+
+/**< Splits count of elements starting at given pointer into array spans. */
+static inline void RingSharedGetSpans (RingShared_t* buffer, uint32_t ptr, RingSpan_t* spans, size_t len){
+	uint32_t index = ptr & buffer -> mask;
+	size_t toEnd = buffer -> size - index;
+
+	spans[0].data = (uint8_t*)buffer -> buffer + (size_t)index * buffer -> elementSize;
+	spans[1].data = buffer -> buffer;
+	if(len > toEnd){
+		spans[0].len = toEnd;
+		spans[1].len = len - toEnd;
+	}else{
+		spans[0].len = len;
+		spans[1].len = 0;
+	}
+}
+
+#ifdef __unix__
+/**< Computes CRC-32 (IEEE 802.3) of data, bit by bit, as only control block is checked. */
+static uint32_t RingCrc32 (uint32_t crc, const void* data, size_t len){
+	const uint8_t* ptr = data;
+
+	crc = ~crc;
+	while(len--){
+		crc ^= *ptr++;
+		for(uint32_t i = 0; i < 8; i++){
+			crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+		}
+	}
+	return ~crc;
+}
+
+/**< Checksum of checkpoint, covering also region configuration. */
+static uint32_t RingCheckpointSum (const RingSharedHeader_t* header, const RingSharedCheckpoint_t* checkpoint){
+	uint32_t crc = RingCrc32(0, &header -> version, sizeof(header -> version));
+	crc = RingCrc32(crc, &header -> size, sizeof(header -> size));
+	crc = RingCrc32(crc, &header -> elementSize, sizeof(header -> elementSize));
+	crc = RingCrc32(crc, &header -> dataOffset, sizeof(header -> dataOffset));
+	crc = RingCrc32(crc, &header -> regionSize, sizeof(header -> regionSize));
+	crc = RingCrc32(crc, &checkpoint -> seq, sizeof(checkpoint -> seq));
+	crc = RingCrc32(crc, &checkpoint -> writePtr, sizeof(checkpoint -> writePtr));
+	return RingCrc32(crc, &checkpoint -> readPtr, sizeof(checkpoint -> readPtr));
+}
+
+/**< Returns the newest checkpoint with valid checksum, NULL if there is none. */
+static const RingSharedCheckpoint_t* RingCheckpointNewest (const RingSharedHeader_t* header){
+	const RingSharedCheckpoint_t* newest = NULL;
+
+	for(uint32_t i = 0; i < 2; i++){
+		const RingSharedCheckpoint_t* checkpoint = &header -> checkpoints[i];
+		if(checkpoint -> checksum == RingCheckpointSum(header, checkpoint) &&
+				checkpoint -> writePtr - checkpoint -> readPtr <= header -> size &&
+				(NULL == newest || checkpoint -> seq > newest -> seq)){
+			newest = checkpoint;
+		}
+	}
+	return newest;
+}
+
+static inline int64_t RingSharedNowNs (void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**< Flushes pages holding given range of mapping to backing file. */
+static int RingSyncRange (const void* data, size_t len){
+	uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+	uintptr_t start = (uintptr_t)data & ~(pageSize - 1);
+	return msync((void*)start, (uintptr_t)data + len - start, MS_SYNC);
+}
+
+/**< Initializes control block of new region, file must be already truncated to regionSize. */
+static RingStatus_t RingSharedFormat (int fd, size_t bufferSize, size_t elementSize,
+		size_t dataOffset, size_t regionSize, uint32_t flags){
+	RingSharedHeader_t* header;
+
+	header = mmap(NULL, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(MAP_FAILED == header) return IO_ERROR;
+
+	header -> version = RING_SHARED_VERSION;
+	header -> size = bufferSize;
+	header -> elementSize = elementSize;
+	header -> dataOffset = dataOffset;
+	header -> regionSize = regionSize;
+	header -> flags = flags;
+	atomic_init(&header -> writePtr, 0);
+	atomic_init(&header -> readPtr, 0);
+	atomic_init(&header -> syncedReadPtr, 0);
+	memset(&header -> checkpoints[0], 0, sizeof(header -> checkpoints));
+	header -> checkpoints[0].seq = 1;
+	header -> checkpoints[0].checksum = RingCheckpointSum(header, &header -> checkpoints[0]);
+	if(flags & RING_SHARED_FLAG_PERSISTENT){
+		/* Magic is made durable last, so file with torn control block is formatted again. */
+		if(RingSyncRange(header, dataOffset) < 0){
+			munmap(header, regionSize);
+			return IO_ERROR;
+		}
+	}
+	/* Published last, attaching process checks it first. */
+	atomic_store_explicit(&header -> magic, RING_SHARED_MAGIC, memory_order_release);
+	if(flags & RING_SHARED_FLAG_PERSISTENT){
+		if(RingSyncRange(header, dataOffset) < 0){
+			munmap(header, regionSize);
+			return IO_ERROR;
+		}
+	}
+	munmap(header, regionSize);
+	return OK;
+}
+
+/**< Maps region of shared memory object and checks its control block. */
+static RingStatus_t RingSharedMap (RingShared_t* buffer, int fd){
+	struct stat st;
+	RingSharedHeader_t* header;
+
+	if(fstat(fd, &st) < 0) return IO_ERROR;
+	if((size_t)st.st_size < RING_SHARED_DATA_OFFSET) return NO_DATA;
+
+	header = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(MAP_FAILED == header) return IO_ERROR;
+
+	/* Region comes from other process, so nothing is trusted before checks. */
+	if(RING_SHARED_MAGIC != atomic_load_explicit(&header -> magic, memory_order_acquire) ||
+			RING_SHARED_VERSION != header -> version ||
+			header -> regionSize != (uint64_t)st.st_size ||
+			header -> size < 2 || (header -> size & (header -> size - 1)) || header -> size > ((uint64_t)1 << 31) ||
+			0 == header -> elementSize ||
+			header -> dataOffset < RING_SHARED_DATA_OFFSET || header -> dataOffset > header -> regionSize ||
+			header -> elementSize > (header -> regionSize - header -> dataOffset) / header -> size){
+		munmap(header, st.st_size);
+		return NO_DATA;
+	}
+
+	buffer -> header = header;
+	buffer -> buffer = (uint8_t*)header + header -> dataOffset;
+	buffer -> regionSize = st.st_size;
+	buffer -> elementSize = header -> elementSize;
+	buffer -> size = header -> size;
+	buffer -> mask = header -> size - 1;
+	buffer -> fd = fd;
+	buffer -> cachedReadPtr = atomic_load_explicit(&header -> readPtr, memory_order_acquire);
+	buffer -> cachedWritePtr = atomic_load_explicit(&header -> writePtr, memory_order_acquire);
+	if(header -> flags & RING_SHARED_FLAG_PERSISTENT){
+		const RingSharedCheckpoint_t* checkpoint = RingCheckpointNewest(header);
+		if(NULL == checkpoint){
+			munmap(header, st.st_size);
+			memset(buffer, 0, sizeof(RingShared_t));
+			buffer -> fd = -1;
+			return NO_DATA;
+		}
+		buffer -> persistent = 1;
+		buffer -> cachedReadPtr = atomic_load_explicit(&header -> syncedReadPtr, memory_order_acquire);
+		buffer -> syncedWritePtr = checkpoint -> writePtr;
+		buffer -> syncSeq = checkpoint -> seq;
+		buffer -> syncTimeNs = RingSharedNowNs();
+	}
+	return OK;
+}
+
+RingStatus_t RingCreateShared (RingShared_t* buffer, const char* name, size_t bufferSize, size_t elementSize){
+	size_t regionSize;
+	RingStatus_t retval;
+	int fd;
+
+	if(NULL == buffer) return NO_PTR;
+	memset(buffer, 0, sizeof(RingShared_t));
+	buffer -> fd = -1;
+
+	if(bufferSize < 2 || (bufferSize & (bufferSize - 1)) || bufferSize > ((size_t)1 << 31)) return NO_DATA;
+	if(elementSize == 0 || elementSize > (SIZE_MAX - RING_SHARED_DATA_OFFSET) / bufferSize) return NO_DATA;
+	regionSize = RING_SHARED_DATA_OFFSET + bufferSize * elementSize;
+
+	if(name){
+		fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	}else{
+#ifdef __linux__
+		fd = memfd_create("ring_shared", MFD_CLOEXEC);
+#else
+		errno = EINVAL;
+		fd = -1;
+#endif
+	}
+	if(fd < 0) return IO_ERROR;
+	if(ftruncate(fd, regionSize) < 0){
+		close(fd);
+		if(name) shm_unlink(name);
+		return IO_ERROR;
+	}
+
+	retval = RingSharedFormat(fd, bufferSize, elementSize, RING_SHARED_DATA_OFFSET, regionSize, 0);
+	if(OK == retval){
+		retval = RingSharedMap(buffer, fd);
+	}
+	if(OK != retval){
+		close(fd);
+		if(name) shm_unlink(name);
+		buffer -> fd = -1;
+	}
+	return retval;
+}
+
+RingStatus_t RingAttachShared (RingShared_t* buffer, const char* name){
+	RingStatus_t retval;
+	int fd;
+
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == name) return NO_PTR;
+	memset(buffer, 0, sizeof(RingShared_t));
+	buffer -> fd = -1;
+
+	fd = shm_open(name, O_RDWR, 0);
+	if(fd < 0) return IO_ERROR;
+	retval = RingSharedMap(buffer, fd);
+	if(OK != retval){
+		close(fd);
+		buffer -> fd = -1;
+	}
+	return retval;
+}
+
+RingStatus_t RingAttachSharedFd (RingShared_t* buffer, int fd){
+	RingStatus_t retval;
+	int dupFd;
+
+	if(NULL == buffer) return NO_PTR;
+	memset(buffer, 0, sizeof(RingShared_t));
+	buffer -> fd = -1;
+
+	dupFd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+	if(dupFd < 0) return IO_ERROR;
+	retval = RingSharedMap(buffer, dupFd);
+	if(OK != retval){
+		close(dupFd);
+		buffer -> fd = -1;
+	}
+	return retval;
+}
+
+RingStatus_t RingOpenPersistent (RingShared_t* buffer, const char* path, size_t bufferSize, size_t elementSize){
+	struct stat st;
+	uint32_t magic = 0;
+	size_t dataOffset, regionSize;
+	size_t pageSize = sysconf(_SC_PAGESIZE);
+	RingStatus_t retval;
+	int fd;
+
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == path) return NO_PTR;
+	memset(buffer, 0, sizeof(RingShared_t));
+	buffer -> fd = -1;
+
+	/* Buffer array starts at page boundary, so syncing it never writes control block. */
+	dataOffset = (RING_SHARED_DATA_OFFSET + pageSize - 1) / pageSize * pageSize;
+	if(bufferSize < 2 || (bufferSize & (bufferSize - 1)) || bufferSize > ((size_t)1 << 31)) return NO_DATA;
+	if(elementSize == 0 || elementSize > (SIZE_MAX - dataOffset) / bufferSize) return NO_DATA;
+	regionSize = dataOffset + bufferSize * elementSize;
+
+	fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+	if(fd < 0) return IO_ERROR;
+	if(fstat(fd, &st) < 0){
+		close(fd);
+		return IO_ERROR;
+	}
+	if(st.st_size > 0 && sizeof(magic) != pread(fd, &magic, sizeof(magic), 0)){
+		close(fd);
+		return IO_ERROR;
+	}
+
+	retval = OK;
+	if(0 == st.st_size || (0 == magic && (size_t)st.st_size == regionSize)){
+		/* New file, or crash happened before it was completely formatted. */
+		if(ftruncate(fd, regionSize) < 0 || fsync(fd) < 0){
+			retval = IO_ERROR;
+		}else{
+			retval = RingSharedFormat(fd, bufferSize, elementSize, dataOffset, regionSize, RING_SHARED_FLAG_PERSISTENT);
+		}
+	}
+	if(OK == retval){
+		retval = RingSharedMap(buffer, fd);
+	}
+	if(OK == retval && (!buffer -> persistent || buffer -> size != bufferSize || buffer -> elementSize != elementSize)){
+		RingCloseShared(buffer);
+		return NO_DATA;
+	}
+	if(OK != retval){
+		close(fd);
+		buffer -> fd = -1;
+		return retval;
+	}
+
+	/* Anything after the newest checkpoint is not known to be on disk. */
+	const RingSharedCheckpoint_t* checkpoint = RingCheckpointNewest(buffer -> header);
+	atomic_store_explicit(&buffer -> header -> writePtr, checkpoint -> writePtr, memory_order_relaxed);
+	atomic_store_explicit(&buffer -> header -> readPtr, checkpoint -> readPtr, memory_order_relaxed);
+	atomic_store_explicit(&buffer -> header -> syncedReadPtr, checkpoint -> readPtr, memory_order_release);
+	buffer -> cachedReadPtr = checkpoint -> readPtr;
+	buffer -> cachedWritePtr = checkpoint -> writePtr;
+	return OK;
+}
+
+RingStatus_t RingSync (RingShared_t* buffer){
+	RingSpan_t spans[2];
+
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == buffer -> header) return NO_PTR;
+	if(!buffer -> persistent) return NO_DATA;
+
+	RingSharedHeader_t* header = buffer -> header;
+	uint32_t head = atomic_load_explicit(&header -> writePtr, memory_order_acquire);
+	uint32_t tail = atomic_load_explicit(&header -> readPtr, memory_order_acquire);
+	uint32_t dirty = head - buffer -> syncedWritePtr;
+
+	if(dirty > buffer -> size){
+		dirty = buffer -> size;
+	}
+	if(dirty){
+		RingSharedGetSpans(buffer, head - dirty, spans, dirty);
+		for(uint32_t i = 0; i < 2; i++){
+			if(spans[i].len && RingSyncRange(spans[i].data, spans[i].len * buffer -> elementSize) < 0){
+				return IO_ERROR;
+			}
+		}
+	}
+
+	/* Older checkpoint is kept intact, in case this one is torn by crash. */
+	RingSharedCheckpoint_t* checkpoint = &header -> checkpoints[(buffer -> syncSeq + 1) & 1];
+	checkpoint -> seq = buffer -> syncSeq + 1;
+	checkpoint -> writePtr = head;
+	checkpoint -> readPtr = tail;
+	checkpoint -> checksum = RingCheckpointSum(header, checkpoint);
+	if(RingSyncRange(checkpoint, sizeof(RingSharedCheckpoint_t)) < 0){
+		return IO_ERROR;
+	}
+
+	buffer -> syncSeq++;
+	buffer -> syncedWritePtr = head;
+	buffer -> syncTimeNs = RingSharedNowNs();
+	/* Data read before checkpoint is not needed for recovery any more. */
+	atomic_store_explicit(&header -> syncedReadPtr, tail, memory_order_release);
+	return OK;
+}
+
+RingStatus_t RingSyncPeriodic (RingShared_t* buffer, uint32_t intervalMs){
+	if(NULL == buffer) return NO_PTR;
+	if(!buffer -> persistent) return NO_DATA;
+
+	if(RingSharedNowNs() - buffer -> syncTimeNs < (int64_t)intervalMs * 1000000){
+		return OK;
+	}
+	return RingSync(buffer);
+}
+
+RingStatus_t RingCloseShared (RingShared_t* buffer){
+	if(NULL == buffer) return NO_PTR;
+
+	if(buffer -> header){
+		munmap(buffer -> header, buffer -> regionSize);
+	}
+	if(buffer -> fd >= 0){
+		close(buffer -> fd);
+	}
+	memset(buffer, 0, sizeof(RingShared_t));
+	buffer -> fd = -1;
+	return OK;
+}
+#endif
+
+uint32_t RingSharedGetDataCnt (RingShared_t* buffer){
+	uint32_t tail = atomic_load_explicit(&buffer -> header -> readPtr, memory_order_acquire);
+	uint32_t head = atomic_load_explicit(&buffer -> header -> writePtr, memory_order_acquire);
+	return head - tail;
+}
+
+uint32_t RingSharedGetSpace (RingShared_t* buffer){
+	if(buffer -> persistent){
+		uint32_t tail = atomic_load_explicit(&buffer -> header -> syncedReadPtr, memory_order_acquire);
+		return buffer -> size - (atomic_load_explicit(&buffer -> header -> writePtr, memory_order_acquire) - tail);
+	}
+	return buffer -> size - RingSharedGetDataCnt(buffer);
+}
+
+RingStatus_t RingSharedWriteElement (RingShared_t* buffer, const void* data){
+	return RingSharedWriteElements(buffer, data, 1);
+}
+
+RingStatus_t RingSharedWriteElements (RingShared_t* buffer, const void* data, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> header == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+
+	RingSpan_t spans[2];
+	size_t elSize = buffer -> elementSize;
+	uint32_t head = atomic_load_explicit(&buffer -> header -> writePtr, memory_order_relaxed);
+
+	if(buffer -> size - (head - buffer -> cachedReadPtr) < len){
+		/* Cached pointer is stale, consumer could have freed some place meanwhile.
+		 * Persistent buffer reuses only place freed before the last checkpoint. */
+		atomic_uint_least32_t* tail = buffer -> persistent ? &buffer -> header -> syncedReadPtr : &buffer -> header -> readPtr;
+		buffer -> cachedReadPtr = atomic_load_explicit(tail, memory_order_acquire);
+		if(buffer -> size - (head - buffer -> cachedReadPtr) < len) return NO_PLACE;
+	}
+
+	RingSharedGetSpans(buffer, head, spans, len);
+	memcpy(spans[0].data, data, spans[0].len * elSize);
+	if(spans[1].len){
+		memcpy(spans[1].data, (const uint8_t*)data + spans[0].len * elSize, spans[1].len * elSize);
+	}
+	atomic_store_explicit(&buffer -> header -> writePtr, head + len, memory_order_release);
+	return OK;
+}
+
+RingStatus_t RingSharedReadElement (RingShared_t* buffer, void* data){
+	return RingSharedReadElements(buffer, data, 1);
+}
+
+RingStatus_t RingSharedReadElements (RingShared_t* buffer, void* data, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> header == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+
+	RingSpan_t spans[2];
+	size_t elSize = buffer -> elementSize;
+	uint32_t tail = atomic_load_explicit(&buffer -> header -> readPtr, memory_order_relaxed);
+
+	if(buffer -> cachedWritePtr - tail < len){
+		/* Cached pointer is stale, producer could have added data meanwhile. */
+		buffer -> cachedWritePtr = atomic_load_explicit(&buffer -> header -> writePtr, memory_order_acquire);
+		if(buffer -> cachedWritePtr - tail < len) return NO_DATA;
+	}
+
+	RingSharedGetSpans(buffer, tail, spans, len);
+	memcpy(data, spans[0].data, spans[0].len * elSize);
+	if(spans[1].len){
+		memcpy((uint8_t*)data + spans[0].len * elSize, spans[1].data, spans[1].len * elSize);
+	}
+	atomic_store_explicit(&buffer -> header -> readPtr, tail + len, memory_order_release);
+	return OK;
+}
+
+/**
+ * @}
+ *
+ */
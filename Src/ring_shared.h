@@ -0,0 +1,260 @@
+/**
+ * @file ring_shared.h
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Cross-process shared memory ring buffer header.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ */
+
+#ifndef RING_SHARED_H_
+#define RING_SHARED_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include "ring.h"
+
+/**
+ * @defgroup Ring_Buffer_Shared
+ * @brief Shared memory variant of the FIFO ring buffer (POSIX only).
+ *
+ * Control block and buffer array lay together in one shared memory region.
+ * Control block holds no pointers, only sizes and offsets, so the region
+ * may be mapped at different addresses in different processes. One producer
+ * and one consumer, possibly in different processes, may use it at the
+ * same time without any lock, as with RingSpsc_t.
+ * @{
+ */
+
+/**< Value of magic field of initialized region, "RING". */
+#define RING_SHARED_MAGIC 0x474E4952u
+
+/**< Version of region layout, bumped on incompatible changes. */
+#define RING_SHARED_VERSION 1u
+
+/**< Region is backed by file and checkpointed by RingSync. */
+#define RING_SHARED_FLAG_PERSISTENT 0x01u
+
+/**
+ * @brief Pointers saved by RingSync in persistent buffer.
+ *
+ */
+typedef struct{
+	uint64_t seq; /**< Sequence number, the newest valid checkpoint is used on recovery. */
+	uint32_t writePtr; /**< Write pointer, data before it was synced. */
+	uint32_t readPtr; /**< Read pointer. */
+	uint32_t checksum; /**< CRC-32 of region configuration and fields above. */
+	uint32_t reserved; /**< Explicit padding, so size does not depend on alignment of uint64_t. */
+} RingSharedCheckpoint_t;
+
+_Static_assert(sizeof(RingSharedCheckpoint_t) == 24, "Checkpoint layout must not depend on word size");
+
+/**
+ * @brief Control block at the beginning of shared region.
+ *
+ * Uses fixed size fields only, so processes built for different word sizes
+ * agree on the layout.
+ */
+typedef struct{
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t magic; /**< RING_SHARED_MAGIC, written last by creator. */
+	uint32_t version; /**< RING_SHARED_VERSION. */
+	uint64_t size; /**< Size of buffer given in elements, power of two. */
+	uint64_t elementSize; /**< Size of one buffer element. */
+	uint64_t dataOffset; /**< Offset of buffer array from region beginning, given in bytes. */
+	uint64_t regionSize; /**< Size of whole region given in bytes. */
+	uint32_t flags; /**< RING_SHARED_FLAG_ values. */
+
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t writePtr; /**< Free-running write pointer, written by producer only. */
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t readPtr; /**< Free-running read pointer, written by consumer only. */
+
+	alignas(RING_CACHE_LINE) RingSharedCheckpoint_t checkpoints[2]; /**< Written alternately by RingSync, persistent buffer only. */
+	atomic_uint_least32_t syncedReadPtr; /**< Read pointer of the newest checkpoint. Producer of
+		persistent buffer overwrites only data before it, so checkpointed data stays intact. */
+} RingSharedHeader_t;
+
+/**
+ * @brief Process-local handle of shared buffer.
+ *
+ */
+typedef struct{
+	RingSharedHeader_t* header; /**< Control block, mapped in this process. */
+	void* buffer; /**< Buffer array, mapped in this process. */
+	size_t regionSize; /**< Size of mapping given in bytes. */
+	size_t elementSize; /**< Size of one buffer element. */
+	uint32_t size; /**< Size of buffer given in elements. */
+	uint32_t mask; /**< Index mask, size - 1. */
+	int fd; /**< Descriptor of shared memory object. */
+	alignas(RING_CACHE_LINE) uint32_t cachedReadPtr; /**< Producer's copy of read pointer. */
+	alignas(RING_CACHE_LINE) uint32_t cachedWritePtr; /**< Consumer's copy of write pointer. */
+	alignas(RING_CACHE_LINE) uint8_t persistent; /**< Region has RING_SHARED_FLAG_PERSISTENT set. */
+	uint32_t syncedWritePtr; /**< Write pointer of the last checkpoint. */
+	uint64_t syncSeq; /**< Sequence number of the last checkpoint. */
+	int64_t syncTimeNs; /**< Monotonic time of the last checkpoint. */
+} RingShared_t;
+
+#ifdef __unix__
+/**
+ * @brief Creates shared memory region and initializes buffer in it.
+ *
+ * With name given, POSIX shared memory object is created (it must not
+ * exist), other processes attach to it with RingAttachShared and creator
+ * removes it with shm_unlink when it is no longer needed. Without name
+ * anonymous memfd is used (Linux only), its descriptor (buffer -> fd) can be
+ * inherited or passed over UNIX socket and attached with RingAttachSharedFd.
+ *
+ * @param buffer Pointer to handle that has to be initialized.
+ * @param name Name of shared memory object, e.g. "/capture", or NULL.
+ * @param bufferSize Size of buffer given in elements, power of two, at least 2.
+ * @param elementSize Size of one element.
+ * @return RingStatus_t NO_DATA if bufferSize is not a power of two,
+ * IO_ERROR if region could not be created (errno is set).
+ */
+RingStatus_t RingCreateShared (RingShared_t* buffer, const char* name, size_t bufferSize, size_t elementSize);
+
+/**
+ * @brief Attaches to buffer created by RingCreateShared in other process.
+ *
+ * Magic, version and sizes of control block are checked before use.
+ *
+ * @param buffer Pointer to handle that has to be initialized.
+ * @param name Name of shared memory object.
+ * @return RingStatus_t IO_ERROR if region could not be opened (errno is set),
+ * NO_DATA if it does not hold valid buffer.
+ */
+RingStatus_t RingAttachShared (RingShared_t* buffer, const char* name);
+
+/**
+ * @brief Attaches to buffer in shared memory object given by descriptor.
+ *
+ * Descriptor is duplicated, caller keeps ownership of fd.
+ *
+ * @param buffer Pointer to handle that has to be initialized.
+ * @param fd Descriptor of shared memory object.
+ * @return RingStatus_t IO_ERROR if region could not be mapped (errno is set),
+ * NO_DATA if it does not hold valid buffer.
+ */
+RingStatus_t RingAttachSharedFd (RingShared_t* buffer, int fd);
+
+/**
+ * @brief Opens buffer backed by memory-mapped file, creating it if needed.
+ *
+ * Data and pointers live in page cache, writes do not wait for disk. Buffer
+ * is made durable by RingSync, which writes checkpoint of pointers. After
+ * crash or restart, pointers are recovered from the newest checkpoint with
+ * valid checksum, so data written after last RingSync is dropped, and data
+ * read after it is read again. Place freed by reads is reused by writes only
+ * after next RingSync, so data of the last checkpoint is never overwritten.
+ * Other processes can attach with RingAttachSharedFd, only one process should
+ * call RingSync.
+ *
+ * @param buffer Pointer to handle that has to be initialized.
+ * @param path Path of backing file.
+ * @param bufferSize Size of buffer given in elements, power of two, at least 2.
+ * @param elementSize Size of one element.
+ * @return RingStatus_t IO_ERROR if file could not be opened or mapped (errno
+ * is set), NO_DATA if sizes are invalid or differ from the existing file's
+ * ones, or file holds no valid checkpoint.
+ */
+RingStatus_t RingOpenPersistent (RingShared_t* buffer, const char* path, size_t bufferSize, size_t elementSize);
+
+/**
+ * @brief Flushes data written since last call to disk, then checkpoints pointers.
+ *
+ * Only dirty pages of buffer array (up to two spans) and control block are
+ * passed to msync. May be called from any thread, but from one at a time.
+ *
+ * @param buffer Pointer to handle of persistent buffer.
+ * @return RingStatus_t NO_DATA if buffer is not persistent, IO_ERROR if msync
+ * failed (errno is set).
+ */
+RingStatus_t RingSync (RingShared_t* buffer);
+
+/**
+ * @brief Calls RingSync if at least intervalMs passed since last checkpoint.
+ *
+ * Cheap enough to be called after every write, so writes are batched into
+ * periodic syncs without separate thread.
+ *
+ * @param buffer Pointer to handle of persistent buffer.
+ * @param intervalMs Minimum time between syncs given in milliseconds.
+ * @return RingStatus_t OK also if sync was not due yet.
+ */
+RingStatus_t RingSyncPeriodic (RingShared_t* buffer, uint32_t intervalMs);
+
+/**
+ * @brief Unmaps region and closes its descriptor. Region itself lives as
+ * long as any process has it mapped (and until its name is unlinked).
+ * Persistent buffer is not synced, RingSync has to be called before.
+ *
+ * @param buffer Pointer to handle.
+ * @return RingStatus_t
+ */
+RingStatus_t RingCloseShared (RingShared_t* buffer);
+#endif
+
+/**
+ * @brief Function that returns count of data available in buffer.
+ *
+ * @param buffer Pointer to handle.
+ * @return uint32_t Data count in buffer given in elements.
+ */
+uint32_t RingSharedGetDataCnt (RingShared_t* buffer);
+
+/**
+ * @brief Function that returns available space in buffer.
+ *
+ * In persistent buffer place freed after the last RingSync is not counted.
+ *
+ * @param buffer Pointer to handle.
+ * @return uint32_t Available space given in elements.
+ */
+uint32_t RingSharedGetSpace (RingShared_t* buffer);
+
+/**
+ * @brief Adds one element to the end of buffer. Producer side only.
+ *
+ * @param buffer Pointer to handle.
+ * @param data Data to write.
+ * @return RingStatus_t Status of write process.
+ */
+RingStatus_t RingSharedWriteElement (RingShared_t* buffer, const void* data);
+
+/**
+ * @brief Writes multiple elements to buffer. Producer side only.
+ *
+ * @param buffer Pointer to handle.
+ * @param data Data pointer to write.
+ * @param len Count of elements to write.
+ * @return RingStatus_t NO_PLACE if there is less than len elements free.
+ */
+RingStatus_t RingSharedWriteElements (RingShared_t* buffer, const void* data, size_t len);
+
+/**
+ * @brief Reads one element from buffer. Consumer side only.
+ *
+ * @param buffer Pointer to handle.
+ * @param data Pointer to save data.
+ * @return RingStatus_t Read status.
+ */
+RingStatus_t RingSharedReadElement (RingShared_t* buffer, void* data);
+
+/**
+ * @brief Reads multiple elements from buffer. Consumer side only.
+ *
+ * @param buffer Pointer to handle.
+ * @param data Pointer to write data.
+ * @param len Count of elements to read.
+ * @return RingStatus_t NO_DATA if there is less than len elements in buffer.
+ */
+RingStatus_t RingSharedReadElements (RingShared_t* buffer, void* data, size_t len);
+
+/**
+ * @}
+ *
+ */
+#endif /* RING_SHARED_H_ */
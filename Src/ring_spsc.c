@@ -0,0 +1,235 @@
+/**
+ * @file ring_spsc.c
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Lock-free single-producer/single-consumer ring buffer source file.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+/**
+ * @copyright GNU General Public License v3.0
+ * @{
+ */
+#include <stdint.h>
+#include <string.h>
+#include "ring_spsc.h"
+#include "ring_futex.h"
+#include "ring_set.h"
+
+/**< Wraps index, which is at most one lap ahead, back into buffer. */
+#define WRAP_BUF(value, max) (((value) >= (max)) ? ((value) - (max)) : (value))
+
+/**< Count of elements between read and write index. */
+static inline uint32_t RingSpscUsed (uint32_t head, uint32_t tail, uint32_t size){
+	return (head >= tail) ? (head - tail) : (head + size - tail);
+}
+
+/**< Wakes other side, if it is parked. Called after index was published and
+ * after seq_cst fence, which pairs with fence in RingSpscWait, so either the
+ * waiter is seen here or its recheck sees the new index. System call is made
+ * only if somebody is parked. */
+static inline void RingSpscWake (atomic_uint_least32_t* waiters, atomic_uint_least32_t* seq){
+	if(atomic_load_explicit(waiters, memory_order_relaxed)){
+		atomic_fetch_add_explicit(seq, 1, memory_order_release);
+		RingFutexWake(seq);
+	}
+}
+
+RingStatus_t RingSpscInit (RingSpsc_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize){
+	if(NULL == buffer) return NO_PTR;
+	if(NULL == arrayBuffer) return NO_PTR;
+
+	memset(buffer, 0, sizeof(RingSpsc_t));
+
+	if(bufferSize < 2) return NO_DATA;
+	if(elementSize == 0) return NO_DATA;
+
+	buffer -> buffer = arrayBuffer;
+	buffer -> size = bufferSize;
+	buffer -> elementSize = elementSize;
+	atomic_init(&buffer -> writePtr, 0);
+	atomic_init(&buffer -> readPtr, 0);
+	buffer -> cachedReadPtr = 0;
+	buffer -> cachedWritePtr = 0;
+	atomic_init(&buffer -> dataSeq, 0);
+	atomic_init(&buffer -> dataWaiters, 0);
+	atomic_init(&buffer -> spaceSeq, 0);
+	atomic_init(&buffer -> spaceWaiters, 0);
+
+	memset(buffer -> buffer, 0, bufferSize * elementSize);
+	return OK;
+}
+
+uint32_t RingSpscGetElementsCapacity (RingSpsc_t* buffer){
+	return buffer -> size;
+}
+
+uint32_t RingSpscGetDataCnt (RingSpsc_t* buffer){
+	uint32_t tail = atomic_load_explicit(&buffer -> readPtr, memory_order_acquire);
+	uint32_t head = atomic_load_explicit(&buffer -> writePtr, memory_order_acquire);
+	return RingSpscUsed(head, tail, buffer -> size);
+}
+
+uint32_t RingSpscGetSpace (RingSpsc_t* buffer){
+	return buffer -> size - 1 - RingSpscGetDataCnt(buffer);
+}
+
+RingStatus_t RingSpscWriteElement (RingSpsc_t* buffer, const void* data){
+	return RingSpscWriteElements(buffer, data, 1);
+}
+
+RingStatus_t RingSpscWriteElements (RingSpsc_t* buffer, const void* data, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+
+	uint32_t size = buffer -> size;
+	uint32_t tempHead = atomic_load_explicit(&buffer -> writePtr, memory_order_relaxed);
+	uint32_t place = size - 1 - RingSpscUsed(tempHead, buffer -> cachedReadPtr, size);
+
+	if(place < len){
+		/* Cached index is stale, consumer could have freed some place meanwhile. */
+		buffer -> cachedReadPtr = atomic_load_explicit(&buffer -> readPtr, memory_order_acquire);
+		place = size - 1 - RingSpscUsed(tempHead, buffer -> cachedReadPtr, size);
+		if(place < len) return NO_PLACE;
+	}
+
+	size_t elSize = buffer -> elementSize;
+	uint8_t* wrPtr = (uint8_t*)buffer -> buffer + (size_t)tempHead * elSize;
+	size_t toEnd = size - tempHead;
+
+	if(len > toEnd){
+		memcpy(wrPtr, data, toEnd * elSize);
+		memcpy(buffer -> buffer, (const uint8_t*)data + toEnd * elSize, (len - toEnd) * elSize);
+	}else{
+		memcpy(wrPtr, data, len * elSize);
+	}
+
+	uint32_t oldHead = tempHead;
+	tempHead = WRAP_BUF(tempHead + len, size);
+	atomic_store_explicit(&buffer -> writePtr, tempHead, memory_order_release);
+	/* Orders published index before waiters and read index checks, pairs with
+	 * fences in RingSpscWait and RingSetNextReady. */
+	atomic_thread_fence(memory_order_seq_cst);
+	RingSpscWake(&buffer -> dataWaiters, &buffer -> dataSeq);
+	if(NULL != buffer -> set){
+		if(oldHead == atomic_load_explicit(&buffer -> readPtr, memory_order_relaxed)){
+			RingSetMark(buffer -> set, buffer -> setIndex);
+		}
+	}
+	return OK;
+}
+
+RingStatus_t RingSpscReadElement (RingSpsc_t* buffer, void* data){
+	return RingSpscReadElements(buffer, data, 1);
+}
+
+RingStatus_t RingSpscReadElements (RingSpsc_t* buffer, void* data, size_t len){
+	if(buffer == NULL) return NO_PTR;
+	if(data == NULL) return NO_PTR;
+	if(buffer -> buffer == NULL) return NO_PTR;
+	if(len <= 0) return NO_DATA;
+
+	uint32_t size = buffer -> size;
+	uint32_t tempTail = atomic_load_explicit(&buffer -> readPtr, memory_order_relaxed);
+	uint32_t count = RingSpscUsed(buffer -> cachedWritePtr, tempTail, size);
+
+	if(count < len){
+		/* Cached index is stale, producer could have added some data meanwhile. */
+		buffer -> cachedWritePtr = atomic_load_explicit(&buffer -> writePtr, memory_order_acquire);
+		count = RingSpscUsed(buffer -> cachedWritePtr, tempTail, size);
+		if(count < len) return NO_DATA;
+	}
+
+	size_t elSize = buffer -> elementSize;
+	const uint8_t* rdPtr = (const uint8_t*)buffer -> buffer + (size_t)tempTail * elSize;
+	size_t toEnd = size - tempTail;
+
+	if(len > toEnd){
+		memcpy(data, rdPtr, toEnd * elSize);
+		memcpy((uint8_t*)data + toEnd * elSize, buffer -> buffer, (len - toEnd) * elSize);
+	}else{
+		memcpy(data, rdPtr, len * elSize);
+	}
+
+	tempTail = WRAP_BUF(tempTail + len, size);
+	atomic_store_explicit(&buffer -> readPtr, tempTail, memory_order_release);
+	atomic_thread_fence(memory_order_seq_cst);
+	RingSpscWake(&buffer -> spaceWaiters, &buffer -> spaceSeq);
+	return OK;
+}
+
+/**< Repeats write (or read) until it succeeds or timeout expires. */
+static RingStatus_t RingSpscWait (RingSpsc_t* buffer, void* data, size_t len, int write,
+		RingWaitStrategy_t strategy, uint32_t timeoutUs){
+	atomic_uint_least32_t* seq = write ? &buffer -> spaceSeq : &buffer -> dataSeq;
+	atomic_uint_least32_t* waiters = write ? &buffer -> spaceWaiters : &buffer -> dataWaiters;
+	RingStatus_t failStatus = write ? NO_PLACE : NO_DATA;
+	int64_t deadline = 0;
+	uint32_t spins = 0;
+	RingStatus_t retval;
+
+	/* One element is kept free, so such request would never be satisfied. */
+	if(len > buffer -> size - 1) return failStatus;
+
+	for(;;){
+		retval = write ? RingSpscWriteElements(buffer, data, len) : RingSpscReadElements(buffer, data, len);
+		if(failStatus != retval || 0 == timeoutUs) return retval;
+
+		if(spins < RING_WAIT_SPIN_COUNT){
+			spins++;
+			continue;
+		}
+		if(RING_WAIT_SPIN == strategy){
+			/* Pure spin reads the clock once per RING_WAIT_SPIN_COUNT checks. */
+			spins = 0;
+		}
+
+		int64_t remaining = -1;
+		if(RING_WAIT_FOREVER != timeoutUs){
+			if(0 == deadline){
+				deadline = RingNowNs() + (int64_t)timeoutUs * 1000;
+			}
+			remaining = deadline - RingNowNs();
+			if(remaining <= 0) return failStatus;
+		}
+
+		if(RING_WAIT_YIELD == strategy){
+			sched_yield();
+		}else if(RING_WAIT_PARK == strategy){
+			atomic_fetch_add_explicit(waiters, 1, memory_order_relaxed);
+			/* Pairs with fence in RingSpscWake: either other side sees this
+			 * waiter, or the recheck below sees its published index. */
+			atomic_thread_fence(memory_order_seq_cst);
+			uint32_t value = atomic_load_explicit(seq, memory_order_acquire);
+			retval = write ? RingSpscWriteElements(buffer, data, len) : RingSpscReadElements(buffer, data, len);
+			if(failStatus == retval){
+				RingFutexWait(seq, value, remaining);
+			}
+			atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+			if(failStatus != retval) return retval;
+		}
+	}
+}
+
+RingStatus_t RingSpscWriteElementsWait (RingSpsc_t* buffer, const void* data, size_t len,
+		RingWaitStrategy_t strategy, uint32_t timeoutUs){
+	if(buffer == NULL) return NO_PTR;
+	return RingSpscWait(buffer, (void*)data, len, 1, strategy, timeoutUs);
+}
+
+RingStatus_t RingSpscReadElementsWait (RingSpsc_t* buffer, void* data, size_t len,
+		RingWaitStrategy_t strategy, uint32_t timeoutUs){
+	if(buffer == NULL) return NO_PTR;
+	return RingSpscWait(buffer, data, len, 0, strategy, timeoutUs);
+}
+
+/**
+ * @}
+ *
+ */
@@ -0,0 +1,196 @@
+/**
+ * @file ring_spsc.h
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Lock-free single-producer/single-consumer ring buffer header.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ */
+
+#ifndef RING_SPSC_H_
+#define RING_SPSC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include "ring.h"
+
+/**
+ * @defgroup Ring_Buffer_Spsc
+ * @brief Lock-free SPSC variant of the FIFO ring buffer.
+ *
+ * One thread may call the write functions and one other thread may call the
+ * read functions at the same time without any external locking.
+ * Write index is owned by producer, read index is owned by consumer, so no
+ * field is written by both sides. Occupancy is derived from both indexes.
+ * @{
+ */
+
+/**< Count of checks done before yielding or parking in wait functions. */
+#ifndef RING_WAIT_SPIN_COUNT
+#define RING_WAIT_SPIN_COUNT 1024
+#endif
+
+/**< Timeout value for wait functions which never expire. */
+#define RING_WAIT_FOREVER UINT32_MAX
+
+/**
+ * @brief Strategy used by wait functions while buffer is empty (or full).
+ *
+ */
+typedef enum{
+	RING_WAIT_SPIN = 0, /**< Busy-spin until condition is met or timeout expires. */
+	RING_WAIT_YIELD, /**< Spin RING_WAIT_SPIN_COUNT times, then yield processor between checks. */
+	RING_WAIT_PARK /**< Spin RING_WAIT_SPIN_COUNT times, then sleep on futex until other side wakes it. */
+} RingWaitStrategy_t;
+
+struct RingSet_s;
+
+/**
+ * @brief SPSC buffer handler structure.
+ *
+ * Read-only configuration, producer data and consumer data lay on separate
+ * cache lines.
+ */
+typedef struct{
+	alignas(RING_CACHE_LINE) size_t size; /**< Size of buffer given in elements. */
+	size_t elementSize; /**< Size of one buffer element. */
+	void* buffer; /**< Pointer to array holding ring buffer. */
+
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t writePtr; /**< Next write index, written by producer only. */
+	uint32_t cachedReadPtr; /**< Producer's copy of consumer's read index. */
+	struct RingSet_s* set; /**< Readiness set buffer is registered in, or NULL. */
+	uint32_t setIndex; /**< Slot of buffer in set. */
+
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t readPtr; /**< Next read index, written by consumer only. */
+	uint32_t cachedWritePtr; /**< Consumer's copy of producer's write index. */
+
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t dataSeq; /**< Futex word consumer parks on, bumped on wake-up. */
+	atomic_uint_least32_t dataWaiters; /**< Count of consumers parked waiting for data. */
+	atomic_uint_least32_t spaceSeq; /**< Futex word producer parks on, bumped on wake-up. */
+	atomic_uint_least32_t spaceWaiters; /**< Count of producers parked waiting for space. */
+} RingSpsc_t;
+
+/**
+ * @brief Function to initialize SPSC ring buffer.
+ *
+ * Must be called before producer and consumer threads start using buffer.
+ * One element of the array is kept free to tell full buffer from empty one.
+ *
+ * @param buffer Pointer to buffer structure that has to be initialized.
+ * @param arrayBuffer Pointer to array used by buffer.
+ * @param bufferSize Size of buffer given in elements.
+ * @param elementSize Size of one element.
+ * @return RingStatus_t
+ */
+RingStatus_t RingSpscInit (RingSpsc_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize);
+
+/**
+ * @brief Function that returns size of whole ring buffer.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return uint32_t Size of buffer given in elements.
+ */
+uint32_t RingSpscGetElementsCapacity (RingSpsc_t* buffer);
+
+/**
+ * @brief Function that returns available space in selected buffer.
+ *
+ * Result is exact when called by producer, from other threads it is a snapshot.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return uint32_t Available space given in elements.
+ */
+uint32_t RingSpscGetSpace (RingSpsc_t* buffer);
+
+/**
+ * @brief Function that returns count of data available in buffer.
+ *
+ * Result is exact when called by consumer, from other threads it is a snapshot.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @return uint32_t Data count in buffer given in elements.
+ */
+uint32_t RingSpscGetDataCnt (RingSpsc_t* buffer);
+
+/**
+ * @brief Adds one element to the end of buffer. Producer side only.
+ *
+ * @param buffer Pointer to buffer to write.
+ * @param data Data to write.
+ * @return RingStatus_t Status of write process.
+ */
+RingStatus_t RingSpscWriteElement (RingSpsc_t* buffer, const void* data);
+
+/**
+ * @brief Writes multiple elements to buffer. Producer side only.
+ *
+ * @param buffer Buffer to write data.
+ * @param data Data pointer to write.
+ * @param len Count of elements to write.
+ * @return RingStatus_t Write status.
+ */
+RingStatus_t RingSpscWriteElements (RingSpsc_t* buffer, const void* data, size_t len);
+
+/**
+ * @brief Reads one element from buffer. Consumer side only.
+ *
+ * @param buffer Buffer to read.
+ * @param data Pointer to save data.
+ * @return RingStatus_t Read status.
+ */
+RingStatus_t RingSpscReadElement (RingSpsc_t* buffer, void* data);
+
+/**
+ * @brief Reads multiple elements from buffer. Consumer side only.
+ *
+ * @param buffer Buffer to read data.
+ * @param data Pointer to write data.
+ * @param len Count of elements to read.
+ * @return RingStatus_t Read status.
+ */
+RingStatus_t RingSpscReadElements (RingSpsc_t* buffer, void* data, size_t len);
+
+/**
+ * @brief Writes multiple elements to buffer, waiting for space if needed. Producer side only.
+ *
+ * Consumer parked in RingSpscReadElementsWait is woken by this function as
+ * well as by RingSpscWriteElements.
+ *
+ * @param buffer Buffer to write data.
+ * @param data Data pointer to write.
+ * @param len Count of elements to write.
+ * @param strategy How to wait for space.
+ * @param timeoutUs Timeout given in microseconds, or RING_WAIT_FOREVER.
+ * @return RingStatus_t NO_PLACE if there was no place until timeout, or at
+ * once if len exceeds buffer capacity.
+ */
+RingStatus_t RingSpscWriteElementsWait (RingSpsc_t* buffer, const void* data, size_t len,
+		RingWaitStrategy_t strategy, uint32_t timeoutUs);
+
+/**
+ * @brief Reads multiple elements from buffer, waiting for data if needed. Consumer side only.
+ *
+ * Producer parked in RingSpscWriteElementsWait is woken by this function as
+ * well as by RingSpscReadElements.
+ *
+ * @param buffer Buffer to read data.
+ * @param data Pointer to write data.
+ * @param len Count of elements to read.
+ * @param strategy How to wait for data.
+ * @param timeoutUs Timeout given in microseconds, or RING_WAIT_FOREVER.
+ * @return RingStatus_t NO_DATA if there was no data until timeout, or at
+ * once if len exceeds buffer capacity.
+ */
+RingStatus_t RingSpscReadElementsWait (RingSpsc_t* buffer, void* data, size_t len,
+		RingWaitStrategy_t strategy, uint32_t timeoutUs);
+
+/**
+ * @}
+ *
+ */
+#endif /* RING_SPSC_H_ */
@@ -0,0 +1,308 @@
+/**
+ * @file bench.c
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Ring buffer benchmarks: throughput, latency and scaling.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Results are printed as CSV (default) or JSON, one record per measurement,
+ * so runs can be diffed. Usage:
+ * bench [--quick] [--format csv|json] [--out file] [--cores a,b] [--threads n]
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "ring.h"
+#include "ring_spsc.h"
+#include "ring_mpmc.h"
+
+/**< Single measurement, printed as one CSV line or JSON object. */
+typedef struct{
+	const char* bench; /**< Benchmark name. */
+	const char* variant; /**< Function or mode measured. */
+	size_t elementSize; /**< Element size given in bytes. */
+	size_t capacity; /**< Buffer capacity given in bytes. */
+	unsigned threads; /**< Count of threads used. */
+	double opsPerS; /**< Elements transferred per second. */
+	double gbPerS; /**< Gigabytes transferred per second. */
+	double p50Ns; /**< Latency percentiles given in nanoseconds, 0 if not measured. */
+	double p99Ns;
+	double p999Ns;
+} BenchResult_t;
+
+static struct{
+	int quick;
+	int json;
+	FILE* out;
+	int cores[2];
+	unsigned threads;
+	unsigned results;
+} bench = { 0, 0, NULL, { 0, 1 }, 0, 0 };
+
+static const size_t benchElementSizes[] = { 1, 8, 64, 512, 4096 };
+static const size_t benchCapacities[] = { 64, 4096, 256 * 1024, 64 * 1024 * 1024 };
+
+static inline uint64_t BenchNowNs (void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/**< Keeps compiler from optimizing away data that is never read. */
+static inline void BenchClobber (void* data){
+	__asm__ volatile("" : : "g"(data) : "memory");
+}
+
+static void BenchReport (const BenchResult_t* r){
+	if(bench.json){
+		fprintf(bench.out, "%s\n  {\"bench\": \"%s\", \"variant\": \"%s\", \"element_size\": %zu, "
+				"\"capacity\": %zu, \"threads\": %u, \"ops_per_s\": %.0f, \"gb_per_s\": %.4f, "
+				"\"p50_ns\": %.0f, \"p99_ns\": %.0f, \"p999_ns\": %.0f}",
+				bench.results ? "," : "[", r -> bench, r -> variant, r -> elementSize, r -> capacity,
+				r -> threads, r -> opsPerS, r -> gbPerS, r -> p50Ns, r -> p99Ns, r -> p999Ns);
+	}else{
+		if(0 == bench.results){
+			fprintf(bench.out, "bench,variant,element_size,capacity,threads,ops_per_s,gb_per_s,p50_ns,p99_ns,p999_ns\n");
+		}
+		fprintf(bench.out, "%s,%s,%zu,%zu,%u,%.0f,%.4f,%.0f,%.0f,%.0f\n", r -> bench, r -> variant,
+				r -> elementSize, r -> capacity, r -> threads, r -> opsPerS, r -> gbPerS,
+				r -> p50Ns, r -> p99Ns, r -> p999Ns);
+	}
+	fflush(bench.out);
+	bench.results++;
+}
+
+static void BenchPin (int core){
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/**< Size from which streaming copy is measured, given in bytes. */
+#define BENCH_STREAM_THRESHOLD (64 * 1024)
+
+/**< RingWriteElement/RingReadElement vs RingWriteElements/RingReadElements,
+ * the latter also with streaming copy if copyThreshold is set.
+ * Writer fills half of buffer, then reader drains it, so buffer capacity
+ * (and thus cache footprint) matters. */
+static void BenchThroughput (size_t elementSize, size_t capacity, int bulk, size_t copyThreshold){
+	RingBuffer_t ring;
+	size_t elements = capacity / elementSize;
+	size_t batch = (elements - 1) / 2;
+	size_t target = (bench.quick ? 16u : 256u) * 1024 * 1024;
+	size_t moved = 0;
+	uint8_t* data;
+
+	if(elements < 4) return;
+	if(copyThreshold && batch * elementSize < copyThreshold) return;
+	if(OK != RingInitAlloc(&ring, elements, elementSize)) return;
+	RingSetCopyThreshold(&ring, copyThreshold);
+	data = calloc(batch, elementSize);
+	if(NULL == data){
+		RingFree(&ring);
+		return;
+	}
+
+	/* Untimed pass, so first-touch page faults are not measured. */
+	RingWriteElements(&ring, data, batch);
+	RingReadElements(&ring, data, batch);
+
+	uint64_t start = BenchNowNs();
+	while(moved < target){
+		if(bulk){
+			RingWriteElements(&ring, data, batch);
+			RingReadElements(&ring, data, batch);
+		}else{
+			for(size_t i = 0; i < batch; i++){
+				RingWriteElement(&ring, data + i * elementSize);
+			}
+			for(size_t i = 0; i < batch; i++){
+				RingReadElement(&ring, data + i * elementSize);
+			}
+		}
+		BenchClobber(data);
+		moved += batch * elementSize;
+	}
+	double seconds = (BenchNowNs() - start) / 1e9;
+
+	BenchResult_t r = { "throughput", copyThreshold ? "RingWriteElements_stream" : bulk ? "RingWriteElements" : "RingWriteElement",
+		elementSize, capacity, 1, moved / elementSize / seconds, moved / seconds / 1e9, 0, 0, 0 };
+	BenchReport(&r);
+	free(data);
+	RingFree(&ring);
+}
+
+static int BenchCompareU64 (const void* a, const void* b){
+	uint64_t x = *(const uint64_t*)a;
+	uint64_t y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static struct{
+	RingSpsc_t ring;
+	uint64_t* samples;
+	size_t count;
+	int yield;
+} latency;
+
+static void* BenchLatencyConsumer (void* arg){
+	uint64_t sent;
+	(void)arg;
+	BenchPin(bench.cores[1]);
+	for(size_t i = 0; i < latency.count; i++){
+		while(OK != RingSpscReadElement(&latency.ring, &sent)){
+			if(latency.yield) sched_yield();
+		}
+		latency.samples[i] = BenchNowNs() - sent;
+	}
+	return NULL;
+}
+
+/**< One-way producer to consumer latency of SPSC buffer, with producer and
+ * consumer pinned to two cores. Next element is sent after previous one was
+ * taken, so queueing is not measured. */
+static void BenchLatency (void){
+	static uint64_t arr[64];
+	pthread_t consumer;
+
+	latency.count = bench.quick ? 10000 : 200000;
+	latency.samples = malloc(latency.count * sizeof(uint64_t));
+	/* On single processor spinning would only wait for the other thread's time slice. */
+	latency.yield = sysconf(_SC_NPROCESSORS_ONLN) < 2;
+	if(NULL == latency.samples) return;
+	RingSpscInit(&latency.ring, &arr[0], 64, sizeof(uint64_t));
+
+	pthread_create(&consumer, NULL, BenchLatencyConsumer, NULL);
+	BenchPin(bench.cores[0]);
+	uint64_t start = BenchNowNs();
+	for(size_t i = 0; i < latency.count; i++){
+		uint64_t now = BenchNowNs();
+		RingSpscWriteElement(&latency.ring, &now);
+		while(RingSpscGetDataCnt(&latency.ring)){
+			if(latency.yield) sched_yield();
+		}
+	}
+	pthread_join(consumer, NULL);
+	double seconds = (BenchNowNs() - start) / 1e9;
+
+	qsort(latency.samples, latency.count, sizeof(uint64_t), BenchCompareU64);
+	BenchResult_t r = { "latency", latency.yield ? "spsc_one_cpu" : "spsc_pinned", sizeof(uint64_t),
+		sizeof(arr), 2, latency.count / seconds, latency.count * sizeof(uint64_t) / seconds / 1e9,
+		latency.samples[latency.count / 2], latency.samples[latency.count * 99 / 100],
+		latency.samples[latency.count * 999 / 1000] };
+	BenchReport(&r);
+	free(latency.samples);
+}
+
+static struct{
+	RingMpmc_t ring;
+	pthread_barrier_t barrier;
+	size_t ops;
+	size_t batch;
+} scaling;
+
+/**< Every thread writes and then reads its batch, so all threads are both
+ * producers and consumers and buffer never gets full. */
+static void* BenchScalingThread (void* arg){
+	uint64_t values[16] = { 0 };
+	unsigned index = (unsigned)(uintptr_t)arg;
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+	BenchPin(index % (cpus > 0 ? cpus : 1));
+	pthread_barrier_wait(&scaling.barrier);
+	for(size_t i = 0; i < scaling.ops; i += scaling.batch){
+		while(OK != RingMpmcWriteElements(&scaling.ring, &values[0], scaling.batch)) sched_yield();
+		while(OK != RingMpmcReadElements(&scaling.ring, &values[0], scaling.batch)) sched_yield();
+	}
+	return NULL;
+}
+
+/**< MPMC buffer throughput from 1 to bench.threads threads. */
+static void BenchScaling (size_t batch){
+	pthread_t threads[256];
+
+	for(unsigned t = 1; t <= bench.threads && t <= 256; t++){
+		scaling.ops = (bench.quick ? 200000 : 2000000) / t;
+		scaling.batch = batch;
+		if(OK != RingMpmcInitAlloc(&scaling.ring, 1024, sizeof(uint64_t))) return;
+		pthread_barrier_init(&scaling.barrier, NULL, t + 1);
+		for(unsigned i = 0; i < t; i++){
+			pthread_create(&threads[i], NULL, BenchScalingThread, (void*)(uintptr_t)i);
+		}
+		uint64_t start = BenchNowNs();
+		pthread_barrier_wait(&scaling.barrier);
+		for(unsigned i = 0; i < t; i++){
+			pthread_join(threads[i], NULL);
+		}
+		double seconds = (BenchNowNs() - start) / 1e9;
+		double ops = (double)scaling.ops * t;
+
+		BenchResult_t r = { "scaling", batch > 1 ? "mpmc_bulk" : "mpmc", sizeof(uint64_t),
+			1024 * sizeof(uint64_t), t, ops / seconds, ops * sizeof(uint64_t) / seconds / 1e9, 0, 0, 0 };
+		BenchReport(&r);
+		pthread_barrier_destroy(&scaling.barrier);
+		RingMpmcFree(&scaling.ring);
+	}
+}
+
+int main (int argc, char** argv){
+	bench.out = stdout;
+	for(int i = 1; i < argc; i++){
+		if(0 == strcmp(argv[i], "--quick")){
+			bench.quick = 1;
+		}else if(0 == strcmp(argv[i], "--format") && i + 1 < argc){
+			bench.json = (0 == strcmp(argv[++i], "json"));
+		}else if(0 == strcmp(argv[i], "--out") && i + 1 < argc){
+			bench.out = fopen(argv[++i], "w");
+			if(NULL == bench.out){
+				perror("bench: --out");
+				return 1;
+			}
+		}else if(0 == strcmp(argv[i], "--cores") && i + 1 < argc){
+			if(2 != sscanf(argv[++i], "%d,%d", &bench.cores[0], &bench.cores[1])){
+				fprintf(stderr, "bench: --cores expects a,b\n");
+				return 1;
+			}
+		}else if(0 == strcmp(argv[i], "--threads") && i + 1 < argc){
+			bench.threads = atoi(argv[++i]);
+		}else{
+			fprintf(stderr, "usage: %s [--quick] [--format csv|json] [--out file] [--cores a,b] [--threads n]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(0 == bench.threads){
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		bench.threads = cpus > 0 ? cpus : 1;
+	}
+
+	for(size_t e = 0; e < sizeof(benchElementSizes) / sizeof(benchElementSizes[0]); e++){
+		for(size_t c = 0; c < sizeof(benchCapacities) / sizeof(benchCapacities[0]); c++){
+			BenchThroughput(benchElementSizes[e], benchCapacities[c], 0, 0);
+			BenchThroughput(benchElementSizes[e], benchCapacities[c], 1, 0);
+			BenchThroughput(benchElementSizes[e], benchCapacities[c], 1, BENCH_STREAM_THRESHOLD);
+		}
+	}
+	BenchLatency();
+	BenchScaling(1);
+	BenchScaling(8);
+
+	if(bench.json){
+		fprintf(bench.out, "\n]\n");
+	}
+	if(bench.out != stdout){
+		fclose(bench.out);
+	}
+	return 0;
+}
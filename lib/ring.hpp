@@ -0,0 +1,197 @@
+/**
+ * @file ring.hpp
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Header-only C++17 FIFO ring buffer template.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ */
+
+#ifndef RING_HPP_
+#define RING_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "ring.h"
+
+/**
+ * @defgroup Ring_Buffer_Cpp
+ * @brief C++ variant of the FIFO ring buffer.
+ * @{
+ */
+
+/**
+ * @brief Ring buffer of N elements of type T, with storage inside the object.
+ *
+ * Element type and capacity are known at compile time, so element copies are
+ * inlined and index wrapping needs no division for power-of-two N. Any type
+ * can be stored, including move-only and non-trivially-copyable ones:
+ * elements are constructed in place and destroyed when taken from buffer.
+ * All N elements are usable. Functions return the same RingStatus_t codes
+ * as C functions.
+ *
+ * @tparam T Element type.
+ * @tparam N Capacity given in elements.
+ */
+template <typename T, std::size_t N>
+class Ring{
+	static_assert(N > 0, "Ring capacity must not be 0");
+
+public:
+	Ring() noexcept = default;
+
+	Ring(const Ring&) = delete;
+	Ring& operator=(const Ring&) = delete;
+
+	~Ring(){
+		clear();
+	}
+
+	/**
+	 * @brief Returns size of whole ring buffer.
+	 *
+	 * @return std::size_t Capacity given in elements.
+	 */
+	static constexpr std::size_t capacity() noexcept{
+		return N;
+	}
+
+	/**
+	 * @brief Returns count of elements in buffer.
+	 *
+	 * @return std::size_t Data count.
+	 */
+	std::size_t size() const noexcept{
+		return writePtr - readPtr;
+	}
+
+	/**
+	 * @brief Returns available space in buffer.
+	 *
+	 * @return std::size_t Available space given in elements.
+	 */
+	std::size_t space() const noexcept{
+		return N - size();
+	}
+
+	bool empty() const noexcept{
+		return writePtr == readPtr;
+	}
+
+	bool full() const noexcept{
+		return size() == N;
+	}
+
+	/**
+	 * @brief Constructs element in place at the end of buffer.
+	 *
+	 * If constructor throws, buffer is left unchanged.
+	 *
+	 * @param args Arguments passed to element constructor.
+	 * @return RingStatus_t NO_PLACE if buffer is full.
+	 */
+	template <typename... Args>
+	RingStatus_t emplace(Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value){
+		if(full()) return NO_PLACE;
+		::new (static_cast<void*>(slot(writePtr))) T(std::forward<Args>(args)...);
+		writePtr++;
+		return OK;
+	}
+
+	/**
+	 * @brief Copies element to the end of buffer.
+	 *
+	 * @param value Element to write.
+	 * @return RingStatus_t NO_PLACE if buffer is full.
+	 */
+	RingStatus_t push(const T& value) noexcept(std::is_nothrow_copy_constructible<T>::value){
+		return emplace(value);
+	}
+
+	/**
+	 * @brief Moves element to the end of buffer.
+	 *
+	 * @param value Element to write.
+	 * @return RingStatus_t NO_PLACE if buffer is full.
+	 */
+	RingStatus_t push(T&& value) noexcept(std::is_nothrow_move_constructible<T>::value){
+		return emplace(std::move(value));
+	}
+
+	/**
+	 * @brief Moves the oldest element out of buffer.
+	 *
+	 * @param value Element to move data to.
+	 * @return RingStatus_t NO_DATA if buffer is empty.
+	 */
+	RingStatus_t pop(T& value) noexcept(std::is_nothrow_move_assignable<T>::value){
+		if(empty()) return NO_DATA;
+		T* element = slot(readPtr);
+		value = std::move(*element);
+		element->~T();
+		readPtr++;
+		return OK;
+	}
+
+	/**
+	 * @brief Removes the oldest element from buffer without reading it.
+	 *
+	 * @return RingStatus_t NO_DATA if buffer is empty.
+	 */
+	RingStatus_t drop() noexcept{
+		if(empty()) return NO_DATA;
+		slot(readPtr)->~T();
+		readPtr++;
+		return OK;
+	}
+
+	/**
+	 * @brief Gives access to the oldest element without taking it.
+	 *
+	 * @return T* Pointer to element, nullptr if buffer is empty.
+	 */
+	T* front() noexcept{
+		return empty() ? nullptr : slot(readPtr);
+	}
+
+	/**
+	 * @brief Gives access to the most recently written element without taking it.
+	 *
+	 * @return T* Pointer to element, nullptr if buffer is empty.
+	 */
+	T* back() noexcept{
+		return empty() ? nullptr : slot(writePtr - 1);
+	}
+
+	/**
+	 * @brief Destroys all elements in buffer.
+	 *
+	 */
+	void clear() noexcept{
+		while(OK == drop()){
+		}
+	}
+
+private:
+	/**< Converts free-running pointer into element slot. Modulo of a
+	 * compile-time constant, a mask for power-of-two N. */
+	T* slot(std::size_t ptr) noexcept{
+		return std::launder(reinterpret_cast<T*>(storage + (ptr % N) * sizeof(T)));
+	}
+
+	alignas(T) unsigned char storage[N * sizeof(T)]; /**< Element storage. */
+	std::size_t writePtr = 0; /**< Free-running next write pointer. */
+	std::size_t readPtr = 0; /**< Free-running next read pointer. */
+};
+
+/**
+ * @}
+ *
+ */
+#endif /* RING_HPP_ */
@@ -0,0 +1,137 @@
+/**
+ * @file ring_arena.h
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Slab arena of compact ring buffers header.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ */
+
+#ifndef RING_ARENA_H_
+#define RING_ARENA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ring.h"
+
+/**
+ * @defgroup Ring_Buffer_Arena
+ * @brief Many small buffers carved out of one allocation.
+ *
+ * Arena holds headers of all its buffers in one contiguous array, followed
+ * by their arrays, all in one slab allocated once. Every buffer has the same
+ * power-of-two size, so buffer is taken and released in O(1) from free list,
+ * and whole arena is released with one free. Header has 16 bytes, so four
+ * headers share one cache line.
+ * @{
+ */
+
+/**
+ * @brief Compact buffer handler, living in arena.
+ *
+ */
+typedef struct{
+	uint32_t writePtr; /**< Free-running write pointer, next free slot while header is unused. */
+	uint32_t readPtr; /**< Free-running read pointer. */
+	uint32_t mask; /**< Index mask (size - 1), 0 while header is unused. */
+	uint32_t index; /**< Position of header in arena, locates buffer array. */
+} RingCompact_t;
+
+/**
+ * @brief Arena handler structure.
+ *
+ */
+typedef struct{
+	RingCompact_t* rings; /**< Headers of all buffers, at slab beginning. */
+	uint8_t* data; /**< Arrays of all buffers, after headers. */
+	size_t elementSize; /**< Size of one element. */
+	size_t stride; /**< Distance between arrays of adjacent buffers, given in bytes. */
+	uint32_t count; /**< Count of buffers in arena. */
+	uint32_t size; /**< Size of every buffer given in elements. */
+	uint32_t used; /**< Count of taken buffers. */
+	uint32_t freeHead; /**< Index of first unused header, UINT32_MAX if none. */
+} RingArena_t;
+
+/**
+ * @brief Allocates arena slab for given count of buffers.
+ *
+ * @param arena Pointer to arena structure that has to be initialized.
+ * @param count Count of buffers.
+ * @param bufferSize Size of every buffer given in elements, power of two.
+ * @param elementSize Size of one element.
+ * @return RingStatus_t NO_DATA if sizes are invalid, NO_PTR if allocation failed
+ * or size of slab would overflow size_t.
+ */
+RingStatus_t RingArenaInit (RingArena_t* arena, size_t count, size_t bufferSize, size_t elementSize);
+
+/**
+ * @brief Releases whole arena at once, with all its buffers.
+ *
+ * @param arena Pointer to arena structure.
+ * @return RingStatus_t
+ */
+RingStatus_t RingArenaFree (RingArena_t* arena);
+
+/**
+ * @brief Takes empty buffer from arena in O(1).
+ *
+ * @param arena Pointer to arena structure.
+ * @return RingCompact_t* Buffer, or NULL if all buffers are taken.
+ */
+RingCompact_t* RingArenaAlloc (RingArena_t* arena);
+
+/**
+ * @brief Returns buffer to arena in O(1), data left in it is dropped.
+ *
+ * @param arena Pointer to arena structure.
+ * @param ring Buffer taken from this arena.
+ * @return RingStatus_t NO_DATA if buffer is not taken from this arena.
+ */
+RingStatus_t RingArenaRelease (RingArena_t* arena, RingCompact_t* ring);
+
+/**
+ * @brief Function that returns count of data available in buffer.
+ *
+ * @param ring Pointer to buffer.
+ * @return uint32_t Data count in buffer given in elements.
+ */
+uint32_t RingCompactGetDataCnt (const RingCompact_t* ring);
+
+/**
+ * @brief Function that returns available space in buffer.
+ *
+ * @param ring Pointer to buffer.
+ * @return uint32_t Available space given in elements.
+ */
+uint32_t RingCompactGetSpace (const RingCompact_t* ring);
+
+/**
+ * @brief Writes multiple elements to buffer.
+ *
+ * @param arena Arena of buffer.
+ * @param ring Buffer to write data.
+ * @param data Data pointer to write.
+ * @param len Count of elements to write.
+ * @return RingStatus_t NO_PLACE if there is less than len elements free.
+ */
+RingStatus_t RingCompactWriteElements (RingArena_t* arena, RingCompact_t* ring, const void* data, size_t len);
+
+/**
+ * @brief Reads multiple elements from buffer.
+ *
+ * @param arena Arena of buffer.
+ * @param ring Buffer to read data.
+ * @param data Pointer to write data.
+ * @param len Count of elements to read.
+ * @return RingStatus_t NO_DATA if there is less than len elements in buffer.
+ */
+RingStatus_t RingCompactReadElements (RingArena_t* arena, RingCompact_t* ring, void* data, size_t len);
+
+/**
+ * @}
+ *
+ */
+#endif /* RING_ARENA_H_ */
@@ -0,0 +1,182 @@
+/**
+ * @file ring_broadcast.h
+ * @author Kacper Brzostowski (kapibrv97@gmail.com)
+ * @link https://github.com/magiczny-kacper
+ * @brief Broadcast (single producer, many consumers) ring buffer header.
+ * @version 2.0.0
+ * @date 2021-02-12
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ */
+
+#ifndef RING_BROADCAST_H_
+#define RING_BROADCAST_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include "ring.h"
+
+/**
+ * @defgroup Ring_Buffer_Broadcast
+ * @brief Broadcast variant of the FIFO ring buffer.
+ *
+ * One producer writes every element once, each registered consumer reads
+ * all of them through its own cursor. Producer is gated by the slowest
+ * consumer. Producer and every consumer may run in separate threads.
+ * @{
+ */
+
+/**< Maximum count of consumers registered in one buffer. */
+#ifndef RING_BROADCAST_MAX_CONSUMERS
+#define RING_BROADCAST_MAX_CONSUMERS 8
+#endif
+
+/**
+ * @brief Consumer cursor, owned by consumer thread.
+ *
+ */
+typedef struct{
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t readPtr; /**< Next element to read by this consumer. */
+	uint32_t cachedWritePtr; /**< Consumer's copy of producer's write pointer. */
+} RingBroadcastCursor_t;
+
+/**
+ * @brief Broadcast buffer handler structure.
+ *
+ */
+typedef struct{
+	alignas(RING_CACHE_LINE) size_t size; /**< Size of buffer given in elements. */
+	size_t elementSize; /**< Size of one buffer element. */
+	uint32_t mask; /**< Index mask, size - 1. */
+	void* buffer; /**< Pointer to array holding ring buffer. */
+	_Atomic(RingBroadcastCursor_t*) consumers[RING_BROADCAST_MAX_CONSUMERS]; /**< Registered cursors. */
+
+	alignas(RING_CACHE_LINE) atomic_uint_least32_t writePtr; /**< Published write pointer, written by producer only. */
+	uint32_t cachedMinReadPtr; /**< Producer's copy of slowest consumer's read pointer. */
+	atomic_uint_least32_t scanners; /**< Count of threads reading registered cursors. */
+} RingBroadcast_t;
+
+/**
+ * @brief Function to initialize broadcast ring buffer.
+ *
+ * @param buffer Pointer to buffer structure that has to be initialized.
+ * @param arrayBuffer Pointer to array used by buffer.
+ * @param bufferSize Size of buffer given in elements, power of two, at least 2.
+ * @param elementSize Size of one element.
+ * @return RingStatus_t NO_DATA if bufferSize is not a power of two.
+ */
+RingStatus_t RingBroadcastInit (RingBroadcast_t* buffer, void* arrayBuffer, size_t bufferSize, size_t elementSize);
+
+/**
+ * @brief Registers consumer cursor in buffer.
+ *
+ * Consumer starts at the current write pointer, so it sees only elements
+ * written after registration.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @param cursor Cursor to register.
+ * @return RingStatus_t NO_PLACE if RING_BROADCAST_MAX_CONSUMERS are registered already,
+ * NO_DATA if cursor is registered already.
+ */
+RingStatus_t RingBroadcastRegister (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor);
+
+/**
+ * @brief Removes consumer cursor from buffer, producer is no longer gated by it.
+ *
+ * Waits until no thread reads pointer of removed cursor, so its memory may be
+ * released once function returns.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @param cursor Cursor to remove.
+ * @return RingStatus_t NO_DATA if cursor was not registered.
+ */
+RingStatus_t RingBroadcastUnregister (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor);
+
+/**
+ * @brief Function that returns count of data available for consumer.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @param cursor Consumer cursor.
+ * @return uint32_t Data count given in elements.
+ */
+uint32_t RingBroadcastGetDataCnt (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor);
+
+/**
+ * @brief Function that returns available space in buffer.
+ *
+ * @param buffer Pointer to buffer structure.
+ * @param cursor Consumer cursor, space is then counted as if it was the only
+ * consumer. If NULL, space for producer (limited by slowest consumer) is returned.
+ * @return uint32_t Available space given in elements.
+ */
+uint32_t RingBroadcastGetSpace (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor);
+
+/**
+ * @brief Adds one element to the end of buffer. Producer side only.
+ *
+ * @param buffer Pointer to buffer to write.
+ * @param data Data to write.
+ * @return RingStatus_t Status of write process.
+ */
+RingStatus_t RingBroadcastWriteElement (RingBroadcast_t* buffer, const void* data);
+
+/**
+ * @brief Writes multiple elements to buffer. Producer side only.
+ *
+ * @param buffer Buffer to write data.
+ * @param data Data pointer to write.
+ * @param len Count of elements to write.
+ * @return RingStatus_t NO_PLACE if slowest consumer did not free enough place.
+ */
+RingStatus_t RingBroadcastWriteElements (RingBroadcast_t* buffer, const void* data, size_t len);
+
+/**
+ * @brief Reads one element from buffer by given consumer.
+ *
+ * @param buffer Buffer to read.
+ * @param cursor Consumer cursor.
+ * @param data Pointer to save data.
+ * @return RingStatus_t Read status.
+ */
+RingStatus_t RingBroadcastReadElement (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor, void* data);
+
+/**
+ * @brief Reads multiple elements from buffer by given consumer.
+ *
+ * @param buffer Buffer to read data.
+ * @param cursor Consumer cursor.
+ * @param data Pointer to write data.
+ * @param len Count of elements to read.
+ * @return RingStatus_t Read status.
+ */
+RingStatus_t RingBroadcastReadElements (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor, void* data, size_t len);
+
+/**
+ * @brief Gives consumer access to batch of data, without copying or taking it.
+ *
+ * @param buffer Buffer to read data.
+ * @param cursor Consumer cursor.
+ * @param spans Array of two spans to fill, second one used only if data wraps.
+ * @param len Count of elements to peek, at most RingBroadcastGetDataCnt.
+ * @return RingStatus_t Read status.
+ */
+RingStatus_t RingBroadcastReadPeek (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor, RingSpan_t* spans, size_t len);
+
+/**
+ * @brief Moves consumer cursor over peeked elements.
+ *
+ * @param buffer Buffer to read data.
+ * @param cursor Consumer cursor.
+ * @param len Count of elements to take.
+ * @return RingStatus_t Read status.
+ */
+RingStatus_t RingBroadcastReadConsume (RingBroadcast_t* buffer, RingBroadcastCursor_t* cursor, size_t len);
+
+/**
+ * @}
+ *
+ */
+#endif /* RING_BROADCAST_H_ */
@@ -2,7 +2,24 @@
 #include <criterion/logging.h>
 #include <criterion/assert.h>
 #include <ring.h>
+#include <ring_spsc.h>
+#include <ring_mpmc.h>
+#include <ring_broadcast.h>
+#include <ring_shared.h>
+#include <ring_set.h>
+#include <ring_arena.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <poll.h>
 
 Test(ring_tests, dummy){
     cr_assert(1, "Hello");
@@ -168,4 +185,1558 @@ Test(ring_tests, get_space)
    RingInit(&myRing, &arr[0], 10, sizeof(uint8_t));
    RingWriteElements(&myRing, &data[0], 5);
    cr_assert(4 == RingGetSpace(&myRing));
-}
\ No newline at end of file
+}
+
+Test(ring_tests, get_data_cnt)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[10];
+   uint8_t data[5] = {1, 1, 1, 1, 1};
+
+   RingInit(&myRing, &arr[0], 10, sizeof(uint8_t));
+   RingWriteElements(&myRing, &data[0], 5);
+   cr_assert(5 == RingGetDataCnt(&myRing));
+}
+
+Test(ring_tests, read_multiple_bytes_overlap)
+{
+   RingBuffer_t myRing;
+   uint16_t arr[10];
+   uint16_t testValues[7] = {1,2,3,4,5,6,7};
+   uint16_t data[7];
+
+   RingInit(&myRing, &arr[0], 10, sizeof(uint16_t));
+   cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 7));
+   cr_assert(OK == RingReadElements(&myRing, &data[0], 7));
+   cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 7));
+   cr_assert(NO_DATA == RingReadElements(&myRing, &data[0], 8));
+   cr_assert(OK == RingReadElements(&myRing, &data[0], 7));
+   cr_assert_arr_eq(&testValues[0], &data[0], sizeof(testValues));
+}
+
+Test(ring_tests, get_last_element)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[10];
+   uint8_t testValues[3] = {1,2,3};
+   uint8_t data;
+
+   RingInit(&myRing, &arr[0], 10, sizeof(uint8_t));
+   cr_assert(NO_DATA == RingGetLastElement(&myRing, &data));
+   RingWriteElements(&myRing, &testValues[0], 3);
+   cr_assert(OK == RingGetLastElement(&myRing, &data));
+   cr_assert(3 == data);
+}
+
+Test(spsc_tests, init){
+   RingSpsc_t myRing;
+   uint8_t arr[10];
+   cr_assert(OK == RingSpscInit(&myRing, &arr[0], 10, sizeof(uint8_t)));
+   cr_assert(10 == RingSpscGetElementsCapacity(&myRing));
+   cr_assert(9 == RingSpscGetSpace(&myRing));
+   cr_assert(0 == RingSpscGetDataCnt(&myRing));
+   cr_assert(NO_PTR == RingSpscInit(&myRing, NULL, 10, sizeof(uint8_t)));
+   cr_assert(NO_DATA == RingSpscInit(&myRing, &arr[0], 1, sizeof(uint8_t)));
+}
+
+Test(spsc_tests, write_read_overlap){
+   RingSpsc_t myRing;
+   uint32_t arr[10];
+   uint32_t testValues[7] = {1,2,3,4,5,6,7};
+   uint32_t data[7];
+   RingSpscInit(&myRing, &arr[0], 10, sizeof(uint32_t));
+
+   cr_assert(OK == RingSpscWriteElements(&myRing, &testValues[0], 7));
+   cr_assert(OK == RingSpscReadElements(&myRing, &data[0], 7));
+   cr_assert(OK == RingSpscWriteElements(&myRing, &testValues[0], 7));
+   cr_assert(7 == RingSpscGetDataCnt(&myRing));
+   cr_assert(OK == RingSpscReadElements(&myRing, &data[0], 7));
+   cr_assert_arr_eq(&testValues[0], &data[0], sizeof(testValues));
+   cr_assert(NO_DATA == RingSpscReadElement(&myRing, &data[0]));
+}
+
+Test(spsc_tests, write_no_place){
+   RingSpsc_t myRing;
+   uint8_t arr[10];
+   uint8_t testValues[9] = {1,2,3,4,5,6,7,8,9};
+   RingSpscInit(&myRing, &arr[0], 10, sizeof(uint8_t));
+
+   cr_assert(NO_PLACE == RingSpscWriteElements(&myRing, &testValues[0], 10));
+   cr_assert(OK == RingSpscWriteElements(&myRing, &testValues[0], 9));
+   cr_assert(NO_PLACE == RingSpscWriteElement(&myRing, &testValues[0]));
+   cr_assert(0 == RingSpscGetSpace(&myRing));
+}
+
+#define SPSC_TEST_COUNT 100000
+
+static void* spsc_producer(void* arg){
+   RingSpsc_t* ring = arg;
+   for(uint32_t i = 0; i < SPSC_TEST_COUNT; i++){
+      while(OK != RingSpscWriteElement(ring, &i)) sched_yield();
+   }
+   return NULL;
+}
+
+Test(spsc_tests, two_threads){
+   RingSpsc_t myRing;
+   uint32_t arr[64];
+   uint32_t data;
+   pthread_t producer;
+   RingSpscInit(&myRing, &arr[0], 64, sizeof(uint32_t));
+
+   pthread_create(&producer, NULL, spsc_producer, &myRing);
+   for(uint32_t i = 0; i < SPSC_TEST_COUNT; i++){
+      while(OK != RingSpscReadElement(&myRing, &data)) sched_yield();
+      cr_assert(i == data, "Excepted %u, got %u", i, data);
+   }
+   pthread_join(producer, NULL);
+}
+
+Test(spsc_tests, wait_timeout)
+{
+   RingSpsc_t myRing;
+   uint8_t arr[4];
+   uint8_t data[4] = {1,2,3,4};
+   struct timespec start, stop;
+   RingSpscInit(&myRing, &arr[0], 4, sizeof(uint8_t));
+
+   clock_gettime(CLOCK_MONOTONIC, &start);
+   cr_assert(NO_DATA == RingSpscReadElementsWait(&myRing, &data[0], 1, RING_WAIT_PARK, 2000));
+   clock_gettime(CLOCK_MONOTONIC, &stop);
+   cr_assert((stop.tv_sec - start.tv_sec) * 1000000000L + (stop.tv_nsec - start.tv_nsec) >= 2000000L);
+
+   cr_assert(OK == RingSpscWriteElementsWait(&myRing, &data[0], 3, RING_WAIT_SPIN, 0));
+   cr_assert(NO_PLACE == RingSpscWriteElementsWait(&myRing, &data[0], 1, RING_WAIT_SPIN, 1000));
+   cr_assert(NO_PLACE == RingSpscWriteElementsWait(&myRing, &data[0], 1, RING_WAIT_YIELD, 1000));
+   cr_assert(0 == atomic_load(&myRing.spaceWaiters));
+
+   // Requests over capacity could never be satisfied
+   cr_assert(NO_DATA == RingSpscReadElementsWait(&myRing, &data[0], 4, RING_WAIT_PARK, RING_WAIT_FOREVER));
+   cr_assert(OK == RingSpscReadElementsWait(&myRing, &data[0], 3, RING_WAIT_PARK, RING_WAIT_FOREVER));
+   cr_assert(NO_PLACE == RingSpscWriteElementsWait(&myRing, &data[0], 4, RING_WAIT_PARK, RING_WAIT_FOREVER));
+}
+
+static void* spsc_wait_producer(void* arg){
+   RingSpsc_t* ring = arg;
+   for(uint32_t i = 0; i < SPSC_TEST_COUNT; i++){
+      if(0 == i % 10000) usleep(1000);
+      RingSpscWriteElementsWait(ring, &i, 1, RING_WAIT_PARK, RING_WAIT_FOREVER);
+   }
+   return NULL;
+}
+
+Test(spsc_tests, wait_park_two_threads)
+{
+   RingSpsc_t myRing;
+   uint32_t arr[16];
+   uint32_t data;
+   pthread_t producer;
+   RingSpscInit(&myRing, &arr[0], 16, sizeof(uint32_t));
+
+   pthread_create(&producer, NULL, spsc_wait_producer, &myRing);
+   for(uint32_t i = 0; i < SPSC_TEST_COUNT; i++){
+      cr_assert(OK == RingSpscReadElementsWait(&myRing, &data, 1, RING_WAIT_PARK, RING_WAIT_FOREVER));
+      cr_assert(i == data, "Excepted %u, got %u", i, data);
+   }
+   pthread_join(producer, NULL);
+   cr_assert(0 == atomic_load(&myRing.dataWaiters));
+}
+
+static void* spsc_plain_producer(void* arg){
+   RingSpsc_t* ring = arg;
+   for(uint32_t i = 0; i < SPSC_TEST_COUNT; i++){
+      if(0 == i % 10000) usleep(1000);
+      while(OK != RingSpscWriteElement(ring, &i)) sched_yield();
+   }
+   return NULL;
+}
+
+Test(spsc_tests, plain_write_wakes_parked)
+{
+   RingSpsc_t myRing;
+   uint32_t arr[16];
+   uint32_t data;
+   pthread_t producer;
+   RingSpscInit(&myRing, &arr[0], 16, sizeof(uint32_t));
+
+   // Consumer parks while producer sleeps, plain writes must wake it
+   pthread_create(&producer, NULL, spsc_plain_producer, &myRing);
+   for(uint32_t i = 0; i < SPSC_TEST_COUNT; i++){
+      cr_assert(OK == RingSpscReadElementsWait(&myRing, &data, 1, RING_WAIT_PARK, RING_WAIT_FOREVER));
+      cr_assert(i == data, "Excepted %u, got %u", i, data);
+   }
+   pthread_join(producer, NULL);
+}
+
+Test(set_tests, next_ready)
+{
+   static RingSpsc_t rings[200];
+   static uint8_t arr[200][4];
+   RingSet_t set;
+   uint8_t data = 7;
+
+   cr_assert(OK == RingSetInitAlloc(&set, 200));
+   for(int i = 0; i < 200; i++){
+      RingSpscInit(&rings[i], &arr[i][0], 4, sizeof(uint8_t));
+      cr_assert(OK == RingSetAdd(&set, &rings[i]));
+   }
+   cr_assert(NO_DATA == RingSetAdd(&set, &rings[0]));
+   cr_assert(NULL == RingSetNextReady(&set));
+   cr_assert(NO_DATA == RingSetWait(&set, 1000));
+
+   RingSpscWriteElement(&rings[150], &data);
+   RingSpscWriteElement(&rings[3], &data);
+   RingSpscWriteElement(&rings[3], &data);
+   cr_assert(OK == RingSetWait(&set, 0));
+   cr_assert(&rings[3] == RingSetNextReady(&set));
+   /* Not drained buffer stays ready, but round-robin goes on to the next one. */
+   RingSpscReadElement(&rings[3], &data);
+   cr_assert(&rings[150] == RingSetNextReady(&set));
+   RingSpscReadElement(&rings[150], &data);
+   cr_assert(&rings[3] == RingSetNextReady(&set));
+   RingSpscReadElement(&rings[3], &data);
+   cr_assert(NULL == RingSetNextReady(&set));
+   cr_assert(NO_DATA == RingSetWait(&set, 0));
+
+   RingSpscWriteElement(&rings[199], &data);
+   cr_assert(OK == RingSetRemove(&set, &rings[199]));
+   cr_assert(NULL == RingSetNextReady(&set));
+   cr_assert(OK == RingSetAdd(&set, &rings[199]));
+   cr_assert(&rings[199] == RingSetNextReady(&set));
+   RingSetFree(&set);
+}
+
+#define SET_TEST_RINGS 4
+
+static RingSpsc_t setRings[SET_TEST_RINGS];
+
+static void* set_producer(void* arg){
+   RingSpsc_t* ring = arg;
+   for(uint32_t i = 0; i < SPSC_TEST_COUNT / SET_TEST_RINGS; i++){
+      if(0 == i % 5000) usleep(500);
+      RingSpscWriteElementsWait(ring, &i, 1, RING_WAIT_YIELD, RING_WAIT_FOREVER);
+   }
+   return NULL;
+}
+
+Test(set_tests, wait_producers)
+{
+   static uint32_t arr[SET_TEST_RINGS][16];
+   uint32_t expected[SET_TEST_RINGS] = {0};
+   pthread_t producers[SET_TEST_RINGS];
+   RingSet_t set;
+   uint32_t data, total = 0;
+
+   RingSetInitAlloc(&set, SET_TEST_RINGS);
+   for(int i = 0; i < SET_TEST_RINGS; i++){
+      RingSpscInit(&setRings[i], &arr[i][0], 16, sizeof(uint32_t));
+      RingSetAdd(&set, &setRings[i]);
+      pthread_create(&producers[i], NULL, set_producer, &setRings[i]);
+   }
+   while(total < SPSC_TEST_COUNT / SET_TEST_RINGS * SET_TEST_RINGS){
+      RingSpsc_t* ring = RingSetNextReady(&set);
+      if(NULL == ring){
+         cr_assert(OK == RingSetWait(&set, 10000000));
+         continue;
+      }
+      int i = ring - &setRings[0];
+      while(OK == RingSpscReadElement(ring, &data)){
+         cr_assert(expected[i] == data, "Excepted %u, got %u", expected[i], data);
+         expected[i]++;
+         total++;
+      }
+   }
+   for(int i = 0; i < SET_TEST_RINGS; i++){
+      pthread_join(producers[i], NULL);
+   }
+   cr_assert(NULL == RingSetNextReady(&set));
+   cr_assert(0 == atomic_load(&set.waiters));
+   RingSetFree(&set);
+}
+
+Test(pow2_tests, init_not_pow2)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[12];
+
+   cr_assert(NO_DATA == RingInitPow2(&myRing, &arr[0], 12, sizeof(uint8_t)));
+   cr_assert(NO_DATA == RingInitPow2(&myRing, &arr[0], 1, sizeof(uint8_t)));
+   cr_assert(OK == RingInitPow2(&myRing, &arr[0], 8, sizeof(uint8_t)));
+   cr_assert(7 == myRing.mask);
+}
+
+Test(pow2_tests, full_capacity)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[8];
+   uint8_t testValues[8] = {1,2,3,4,5,6,7,8};
+   uint8_t data[8];
+
+   RingInitPow2(&myRing, &arr[0], 8, sizeof(uint8_t));
+   cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 8));
+   cr_assert(0 == RingGetSpace(&myRing));
+   cr_assert(8 == RingGetDataCnt(&myRing));
+   cr_assert(NO_PLACE == RingWriteElement(&myRing, &testValues[0]));
+   cr_assert(OK == RingReadElements(&myRing, &data[0], 8));
+   cr_assert_arr_eq(&testValues[0], &data[0], 8);
+   cr_assert(NO_DATA == RingReadElement(&myRing, &data[0]));
+}
+
+Test(pow2_tests, counters_wrap)
+{
+   RingBuffer_t myRing;
+   uint32_t arr[4];
+   uint32_t testValues[3] = {1,2,3};
+   uint32_t data[3];
+
+   RingInitPow2(&myRing, &arr[0], 4, sizeof(uint32_t));
+   // Free-running pointers just before 32-bit overflow
+   myRing.writePtr = UINT32_MAX - 1;
+   myRing.readPtr = UINT32_MAX - 1;
+   cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 3));
+   cr_assert(3 == RingGetDataCnt(&myRing));
+   cr_assert(1 == RingGetHead(&myRing));
+   cr_assert(OK == RingReadElements(&myRing, &data[0], 3));
+   cr_assert_arr_eq(&testValues[0], &data[0], sizeof(testValues));
+   cr_assert(4 == RingGetSpace(&myRing));
+}
+
+Test(zero_copy_tests, reserve_commit_overlap)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[10];
+   uint8_t testValues[5] = {1,2,3,4,5};
+   uint8_t arrRef[10] = {3,4,5,0,0,0,0,0,1,2};
+   RingSpan_t spans[2];
+
+   RingInit(&myRing, &arr[0], 10, sizeof(uint8_t));
+   myRing.writePtr = 8;
+   myRing.readPtr = 8;
+   cr_assert(OK == RingWriteReserve(&myRing, &spans[0], 5));
+   cr_assert(2 == spans[0].len);
+   cr_assert(3 == spans[1].len);
+   cr_assert(&arr[8] == spans[0].data);
+   cr_assert(&arr[0] == spans[1].data);
+   cr_assert(0 == RingGetDataCnt(&myRing));
+   memcpy(spans[0].data, &testValues[0], spans[0].len);
+   memcpy(spans[1].data, &testValues[2], spans[1].len);
+   cr_assert(OK == RingWriteCommit(&myRing, 5));
+   cr_assert(5 == RingGetDataCnt(&myRing));
+   cr_assert_arr_eq(&arrRef[0], &arr[0], 10);
+}
+
+Test(zero_copy_tests, reserve_no_place)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[10];
+   RingSpan_t spans[2];
+
+   RingInit(&myRing, &arr[0], 10, sizeof(uint8_t));
+   cr_assert(NO_PLACE == RingWriteReserve(&myRing, &spans[0], 10));
+   cr_assert(OK == RingWriteReserve(&myRing, &spans[0], 9));
+   cr_assert(0 == spans[1].len);
+   cr_assert(NO_PLACE == RingWriteCommit(&myRing, 10));
+}
+
+Test(zero_copy_tests, peek_consume)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[8];
+   uint8_t testValues[6] = {1,2,3,4,5,6};
+   RingSpan_t spans[2];
+
+   RingInitPow2(&myRing, &arr[0], 8, sizeof(uint8_t));
+   cr_assert(NO_DATA == RingReadPeek(&myRing, &spans[0], 1));
+   RingWriteElements(&myRing, &testValues[0], 6);
+   RingReadConsume(&myRing, 4);
+   RingWriteElements(&myRing, &testValues[0], 6);
+   cr_assert(OK == RingReadPeek(&myRing, &spans[0], 8));
+   cr_assert(4 == spans[0].len);
+   cr_assert(4 == spans[1].len);
+   cr_assert_arr_eq(&testValues[4], spans[0].data, 2);
+   cr_assert_arr_eq(&testValues[0], (uint8_t*)spans[0].data + 2, 2);
+   cr_assert_arr_eq(&testValues[2], spans[1].data, 4);
+   cr_assert(8 == RingGetDataCnt(&myRing));
+   cr_assert(OK == RingReadConsume(&myRing, 8));
+   cr_assert(NO_DATA == RingReadConsume(&myRing, 1));
+}
+
+Test(partial_tests, write_read_some)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[10];
+   uint8_t testValues[6] = {1,2,3,4,5,6};
+   uint8_t data[10];
+   size_t cnt;
+
+   RingInit(&myRing, &arr[0], 10, sizeof(uint8_t));
+   cr_assert(OK == RingWriteSome(&myRing, &testValues[0], 6, &cnt));
+   cr_assert(6 == cnt);
+   cr_assert(OK == RingWriteSome(&myRing, &testValues[0], 6, &cnt));
+   cr_assert(3 == cnt);
+   cr_assert(NO_PLACE == RingWriteSome(&myRing, &testValues[0], 6, &cnt));
+   cr_assert(0 == cnt);
+   cr_assert(OK == RingReadSome(&myRing, &data[0], 10, &cnt));
+   cr_assert(9 == cnt);
+   cr_assert_arr_eq(&testValues[0], &data[0], 6);
+   cr_assert_arr_eq(&testValues[0], &data[6], 3);
+   cr_assert(NO_DATA == RingReadSome(&myRing, &data[0], 10, &cnt));
+   cr_assert(0 == cnt);
+}
+
+Test(partial_tests, transfer_wrapped)
+{
+   RingBuffer_t src, dst;
+   uint8_t srcArr[8], dstArr[8];
+   uint8_t testValues[8] = {1,2,3,4,5,6,7,8};
+   uint8_t data[8];
+   size_t cnt;
+   uint16_t wide[4];
+
+   RingInitPow2(&src, &srcArr[0], 8, sizeof(uint8_t));
+   RingInitPow2(&dst, &dstArr[0], 8, sizeof(uint8_t));
+   cr_assert(NO_DATA == RingTransfer(&dst, &src, 8, &cnt));
+   /* Data of src wraps after 3 elements, free place of dst after 5. */
+   RingWriteElements(&src, &testValues[0], 5);
+   RingReadConsume(&src, 5);
+   RingWriteElements(&src, &testValues[0], 7);
+   RingWriteElements(&dst, &testValues[0], 3);
+   RingReadConsume(&dst, 3);
+   RingWriteElements(&dst, &testValues[0], 1);
+   cr_assert(OK == RingTransfer(&dst, &src, 8, &cnt));
+   cr_assert(7 == cnt);
+   cr_assert(0 == RingGetDataCnt(&src));
+   cr_assert(OK == RingReadElements(&dst, &data[0], 8));
+   cr_assert(1 == data[0]);
+   cr_assert_arr_eq(&testValues[0], &data[1], 7);
+
+   RingWriteElements(&src, &testValues[0], 8);
+   RingWriteElements(&dst, &testValues[0], 6);
+   cr_assert(OK == RingTransfer(&dst, &src, 8, &cnt));
+   cr_assert(2 == cnt);
+   cr_assert(NO_PLACE == RingTransfer(&dst, &src, 8, &cnt));
+   cr_assert(6 == RingGetDataCnt(&src));
+
+   RingInitPow2(&dst, &wide[0], 4, sizeof(uint16_t));
+   cr_assert(NO_DATA == RingTransfer(&dst, &src, 1, &cnt));
+}
+
+Test(mirrored_tests, init_not_page_multiple)
+{
+   RingBuffer_t myRing;
+   cr_assert(NO_DATA == RingInitMirrored(&myRing, 100, sizeof(uint8_t)));
+   cr_assert(NO_PTR == RingInitMirrored(NULL, 4096, sizeof(uint8_t)));
+}
+
+Test(mirrored_tests, overlap_is_contiguous)
+{
+   RingBuffer_t myRing;
+   uint8_t testValues[200];
+   uint8_t data[200];
+   RingSpan_t spans[2];
+   for(uint32_t i = 0; i < sizeof(testValues); i++) testValues[i] = i;
+
+   cr_assert(OK == RingInitMirrored(&myRing, 4096, sizeof(uint8_t)));
+   myRing.writePtr = 4000;
+   myRing.readPtr = 4000;
+   cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 200));
+   cr_assert(OK == RingReadPeek(&myRing, &spans[0], 200));
+   cr_assert(200 == spans[0].len);
+   cr_assert(0 == spans[1].len);
+   cr_assert_arr_eq(&testValues[0], spans[0].data, 200);
+   // Second half of mapping is the same memory as array beginning
+   cr_assert_arr_eq(&testValues[96], myRing.buffer, 104);
+   cr_assert(OK == RingReadElements(&myRing, &data[0], 200));
+   cr_assert_arr_eq(&testValues[0], &data[0], 200);
+   cr_assert(OK == RingFree(&myRing));
+   cr_assert(NULL == myRing.buffer);
+}
+
+Test(mpmc_tests, init)
+{
+   RingMpmc_t myRing;
+   uint32_t arr[RING_MPMC_ARRAY_SIZE(8, sizeof(uint32_t)) / sizeof(uint32_t)];
+
+   cr_assert(NO_DATA == RingMpmcInit(&myRing, &arr[0], 6, sizeof(uint32_t)));
+   cr_assert(NO_PTR == RingMpmcInit(&myRing, NULL, 8, sizeof(uint32_t)));
+   cr_assert(OK == RingMpmcInit(&myRing, &arr[0], 8, sizeof(uint32_t)));
+   cr_assert(8 == RingMpmcGetSpace(&myRing));
+   cr_assert(0 == RingMpmcGetDataCnt(&myRing));
+}
+
+Test(mpmc_tests, bulk_write_read)
+{
+   RingMpmc_t myRing;
+   uint16_t testValues[6] = {1,2,3,4,5,6};
+   uint16_t data[6];
+
+   cr_assert(OK == RingMpmcInitAlloc(&myRing, 8, sizeof(uint16_t)));
+   cr_assert(OK == RingMpmcWriteElements(&myRing, &testValues[0], 6));
+   cr_assert(NO_PLACE == RingMpmcWriteElements(&myRing, &testValues[0], 3));
+   cr_assert(OK == RingMpmcReadElements(&myRing, &data[0], 4));
+   cr_assert_arr_eq(&testValues[0], &data[0], 4 * sizeof(uint16_t));
+   cr_assert(OK == RingMpmcWriteElements(&myRing, &testValues[0], 6));
+   cr_assert(8 == RingMpmcGetDataCnt(&myRing));
+   cr_assert(NO_DATA == RingMpmcReadElements(&myRing, &data[0], 9));
+   cr_assert(OK == RingMpmcReadElements(&myRing, &data[0], 2));
+   cr_assert_arr_eq(&testValues[4], &data[0], 2 * sizeof(uint16_t));
+   cr_assert(OK == RingMpmcReadElements(&myRing, &data[0], 6));
+   cr_assert_arr_eq(&testValues[0], &data[0], sizeof(testValues));
+   cr_assert(NO_DATA == RingMpmcReadElement(&myRing, &data[0]));
+   cr_assert(OK == RingMpmcFree(&myRing));
+}
+
+#define MPMC_TEST_THREADS 4
+#define MPMC_TEST_COUNT 50000
+
+static RingMpmc_t mpmcRing;
+static atomic_uint_least64_t mpmcSum;
+
+static void* mpmc_producer(void* arg){
+   uint64_t values[2];
+   (void)arg;
+   for(uint64_t i = 1; i <= MPMC_TEST_COUNT; i += 2){
+      values[0] = i;
+      values[1] = i + 1;
+      while(OK != RingMpmcWriteElements(&mpmcRing, &values[0], 2)) sched_yield();
+   }
+   return NULL;
+}
+
+static void* mpmc_consumer(void* arg){
+   uint64_t value;
+   uint64_t sum = 0;
+   (void)arg;
+   for(uint32_t i = 0; i < MPMC_TEST_COUNT; i++){
+      while(OK != RingMpmcReadElement(&mpmcRing, &value)) sched_yield();
+      sum += value;
+   }
+   atomic_fetch_add(&mpmcSum, sum);
+   return NULL;
+}
+
+Test(mpmc_tests, many_threads)
+{
+   pthread_t threads[2 * MPMC_TEST_THREADS];
+   uint64_t expected = (uint64_t)MPMC_TEST_THREADS * MPMC_TEST_COUNT * (MPMC_TEST_COUNT + 1) / 2;
+
+   RingMpmcInitAlloc(&mpmcRing, 64, sizeof(uint64_t));
+   atomic_init(&mpmcSum, 0);
+   for(int i = 0; i < MPMC_TEST_THREADS; i++){
+      pthread_create(&threads[2 * i], NULL, mpmc_producer, NULL);
+      pthread_create(&threads[2 * i + 1], NULL, mpmc_consumer, NULL);
+   }
+   for(int i = 0; i < 2 * MPMC_TEST_THREADS; i++){
+      pthread_join(threads[i], NULL);
+   }
+   cr_assert(expected == atomic_load(&mpmcSum));
+   cr_assert(0 == RingMpmcGetDataCnt(&mpmcRing));
+   RingMpmcFree(&mpmcRing);
+}
+
+Test(broadcast_tests, gated_by_slowest)
+{
+   RingBroadcast_t myRing;
+   RingBroadcastCursor_t fast, slow;
+   uint8_t arr[8];
+   uint8_t testValues[6] = {1,2,3,4,5,6};
+   uint8_t data[6];
+
+   cr_assert(NO_DATA == RingBroadcastInit(&myRing, &arr[0], 10, sizeof(uint8_t)));
+   cr_assert(OK == RingBroadcastInit(&myRing, &arr[0], 8, sizeof(uint8_t)));
+   cr_assert(OK == RingBroadcastRegister(&myRing, &fast));
+   cr_assert(OK == RingBroadcastRegister(&myRing, &slow));
+
+   cr_assert(OK == RingBroadcastWriteElements(&myRing, &testValues[0], 6));
+   cr_assert(OK == RingBroadcastReadElements(&myRing, &fast, &data[0], 6));
+   cr_assert_arr_eq(&testValues[0], &data[0], 6);
+   cr_assert(0 == RingBroadcastGetDataCnt(&myRing, &fast));
+   cr_assert(6 == RingBroadcastGetDataCnt(&myRing, &slow));
+   cr_assert(8 == RingBroadcastGetSpace(&myRing, &fast));
+   cr_assert(2 == RingBroadcastGetSpace(&myRing, NULL));
+   cr_assert(NO_PLACE == RingBroadcastWriteElements(&myRing, &testValues[0], 3));
+
+   cr_assert(OK == RingBroadcastReadElements(&myRing, &slow, &data[0], 6));
+   cr_assert_arr_eq(&testValues[0], &data[0], 6);
+   cr_assert(OK == RingBroadcastWriteElements(&myRing, &testValues[0], 6));
+   cr_assert(OK == RingBroadcastUnregister(&myRing, &slow));
+   cr_assert(NO_DATA == RingBroadcastUnregister(&myRing, &slow));
+   cr_assert(OK == RingBroadcastReadElements(&myRing, &fast, &data[0], 6));
+   cr_assert(OK == RingBroadcastWriteElements(&myRing, &testValues[0], 2));
+}
+
+Test(broadcast_tests, register_twice)
+{
+   RingBroadcast_t myRing;
+   RingBroadcastCursor_t cursor;
+   uint8_t arr[8];
+   uint8_t testValues[8] = {1,2,3,4,5,6,7,8};
+
+   RingBroadcastInit(&myRing, &arr[0], 8, sizeof(uint8_t));
+   cr_assert(OK == RingBroadcastRegister(&myRing, &cursor));
+   cr_assert(OK == RingBroadcastWriteElements(&myRing, &testValues[0], 3));
+   // Cursor keeps its position and takes only one slot
+   cr_assert(NO_DATA == RingBroadcastRegister(&myRing, &cursor));
+   cr_assert(3 == RingBroadcastGetDataCnt(&myRing, &cursor));
+   cr_assert(OK == RingBroadcastUnregister(&myRing, &cursor));
+   cr_assert(NO_DATA == RingBroadcastUnregister(&myRing, &cursor));
+   // Producer is not gated by unregistered cursor anymore
+   cr_assert(OK == RingBroadcastWriteElements(&myRing, &testValues[0], 8));
+}
+
+Test(broadcast_tests, peek_batch)
+{
+   RingBroadcast_t myRing;
+   RingBroadcastCursor_t cursor;
+   uint32_t arr[4];
+   uint32_t testValues[3] = {1,2,3};
+   RingSpan_t spans[2];
+
+   RingBroadcastInit(&myRing, &arr[0], 4, sizeof(uint32_t));
+   RingBroadcastRegister(&myRing, &cursor);
+   RingBroadcastWriteElements(&myRing, &testValues[0], 3);
+   RingBroadcastReadConsume(&myRing, &cursor, 3);
+   RingBroadcastWriteElements(&myRing, &testValues[0], 3);
+   cr_assert(OK == RingBroadcastReadPeek(&myRing, &cursor, &spans[0], RingBroadcastGetDataCnt(&myRing, &cursor)));
+   cr_assert(1 == spans[0].len);
+   cr_assert(2 == spans[1].len);
+   cr_assert(1 == *(uint32_t*)spans[0].data);
+   cr_assert_arr_eq(&testValues[1], spans[1].data, 2 * sizeof(uint32_t));
+   cr_assert(OK == RingBroadcastReadConsume(&myRing, &cursor, 3));
+   cr_assert(NO_DATA == RingBroadcastReadConsume(&myRing, &cursor, 1));
+}
+
+#define BROADCAST_TEST_CONSUMERS 3
+#define BROADCAST_TEST_COUNT 50000
+
+static RingBroadcast_t broadcastRing;
+static RingBroadcastCursor_t broadcastCursors[BROADCAST_TEST_CONSUMERS];
+static atomic_int broadcastErrors;
+
+static void* broadcast_consumer(void* arg){
+   RingBroadcastCursor_t* cursor = arg;
+   uint32_t value;
+   for(uint32_t i = 0; i < BROADCAST_TEST_COUNT; i++){
+      while(OK != RingBroadcastReadElement(&broadcastRing, cursor, &value)) sched_yield();
+      if(value != i) atomic_fetch_add(&broadcastErrors, 1);
+   }
+   return NULL;
+}
+
+Test(broadcast_tests, many_consumers)
+{
+   static uint32_t arr[32];
+   pthread_t threads[BROADCAST_TEST_CONSUMERS];
+
+   RingBroadcastInit(&broadcastRing, &arr[0], 32, sizeof(uint32_t));
+   atomic_init(&broadcastErrors, 0);
+   for(int i = 0; i < BROADCAST_TEST_CONSUMERS; i++){
+      RingBroadcastRegister(&broadcastRing, &broadcastCursors[i]);
+      pthread_create(&threads[i], NULL, broadcast_consumer, &broadcastCursors[i]);
+   }
+   for(uint32_t i = 0; i < BROADCAST_TEST_COUNT; i++){
+      while(OK != RingBroadcastWriteElement(&broadcastRing, &i)) sched_yield();
+   }
+   for(int i = 0; i < BROADCAST_TEST_CONSUMERS; i++){
+      pthread_join(threads[i], NULL);
+   }
+   cr_assert(0 == atomic_load(&broadcastErrors));
+}
+
+static void* broadcast_producer(void* arg){
+   (void)arg;
+   for(uint32_t i = 0; i < BROADCAST_TEST_COUNT; i++){
+      while(OK != RingBroadcastWriteElement(&broadcastRing, &i)) sched_yield();
+   }
+   return NULL;
+}
+
+Test(broadcast_tests, unregister_then_free)
+{
+   static uint32_t arr[32];
+   RingBroadcastCursor_t cursor;
+   pthread_t producer;
+   uint32_t value;
+   int errors = 0;
+
+   RingBroadcastInit(&broadcastRing, &arr[0], 32, sizeof(uint32_t));
+   RingBroadcastRegister(&broadcastRing, &cursor);
+   pthread_create(&producer, NULL, broadcast_producer, NULL);
+   for(uint32_t i = 0; i < BROADCAST_TEST_COUNT; i++){
+      if(0 == i % 25){
+         // Producer scanning cursors must not use one after unregister returned
+         RingBroadcastCursor_t* transient = malloc(sizeof(RingBroadcastCursor_t));
+         cr_assert(OK == RingBroadcastRegister(&broadcastRing, transient));
+         cr_assert(OK == RingBroadcastUnregister(&broadcastRing, transient));
+         atomic_store(&transient -> readPtr, atomic_load(&broadcastRing.writePtr) + 1);
+         free(transient);
+      }
+      while(OK != RingBroadcastReadElement(&broadcastRing, &cursor, &value)) sched_yield();
+      if(value != i) errors++;
+   }
+   pthread_join(producer, NULL);
+   cr_assert(0 == errors);
+}
+
+Test(fd_tests, pipe_round_trip_overlap)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[16];
+   uint8_t testValues[10] = {1,2,3,4,5,6,7,8,9,10};
+   uint8_t data[10];
+   size_t transferred;
+   int fds[2];
+
+   cr_assert(0 == pipe(fds));
+   RingInitPow2(&myRing, &arr[0], 16, sizeof(uint8_t));
+   myRing.writePtr = 12;
+   myRing.readPtr = 12;
+
+   // Empty request is not reported as descriptor that would block
+   transferred = 1;
+   cr_assert(OK == RingWriteFromFd(&myRing, fds[0], 0, &transferred));
+   cr_assert(0 == transferred);
+   cr_assert(10 == write(fds[1], &testValues[0], 10));
+   cr_assert(OK == RingWriteFromFd(&myRing, fds[0], 100, &transferred));
+   cr_assert(10 == transferred);
+   cr_assert(10 == RingGetDataCnt(&myRing));
+
+   transferred = 1;
+   cr_assert(OK == RingReadToFd(&myRing, fds[1], 0, &transferred));
+   cr_assert(0 == transferred);
+   cr_assert(10 == RingGetDataCnt(&myRing));
+   cr_assert(OK == RingReadToFd(&myRing, fds[1], 6, &transferred));
+   cr_assert(6 == transferred);
+   cr_assert(OK == RingReadToFd(&myRing, fds[1], 100, &transferred));
+   cr_assert(4 == transferred);
+   cr_assert(NO_DATA == RingReadToFd(&myRing, fds[1], 100, &transferred));
+   cr_assert(10 == read(fds[0], &data[0], 10));
+   cr_assert_arr_eq(&testValues[0], &data[0], 10);
+
+   close(fds[1]);
+   cr_assert(OK == RingWriteFromFd(&myRing, fds[0], 100, &transferred));
+   cr_assert(0 == transferred);
+   close(fds[0]);
+}
+
+Test(fd_tests, non_blocking)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[8];
+   uint8_t testValues[7] = {1,2,3,4,5,6,7};
+   size_t transferred;
+   int fds[2];
+
+   cr_assert(0 == pipe(fds));
+   fcntl(fds[0], F_SETFL, O_NONBLOCK);
+   RingInit(&myRing, &arr[0], 8, sizeof(uint8_t));
+
+   cr_assert(NO_DATA == RingWriteFromFd(&myRing, fds[0], 100, &transferred));
+   cr_assert(7 == write(fds[1], &testValues[0], 7));
+   cr_assert(OK == RingWriteFromFd(&myRing, fds[0], 100, &transferred));
+   cr_assert(7 == transferred);
+   cr_assert(NO_PLACE == RingWriteFromFd(&myRing, fds[0], 100, &transferred));
+   cr_assert(0 == transferred);
+   close(fds[0]);
+   close(fds[1]);
+}
+
+Test(overwrite_tests, needs_pow2)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[10];
+
+   RingInit(&myRing, &arr[0], 10, sizeof(uint8_t));
+   cr_assert(NO_DATA == RingSetOverwrite(&myRing, 1));
+   RingInitPow2(&myRing, &arr[0], 8, sizeof(uint8_t));
+   cr_assert(OK == RingSetOverwrite(&myRing, 1));
+}
+
+Test(overwrite_tests, keeps_newest)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[8];
+   uint8_t testValues[6] = {1,2,3,4,5,6};
+   uint8_t data[8];
+   uint8_t dataRef[8] = {6,1,2,3,4,5,6,6};
+
+   RingInitPow2(&myRing, &arr[0], 8, sizeof(uint8_t));
+   RingSetOverwrite(&myRing, 1);
+   cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 6));
+   cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 6));
+   cr_assert(4 == RingGetOverwriteCnt(&myRing));
+   cr_assert(8 == RingGetDataCnt(&myRing));
+   cr_assert(OK == RingWriteElement(&myRing, &testValues[5]));
+   cr_assert(5 == RingGetOverwriteCnt(&myRing));
+   cr_assert(OK == RingReadElements(&myRing, &data[0], 8));
+   cr_assert_arr_eq(&dataRef[0], &data[0], 8);
+   cr_assert(NO_DATA == RingReadElement(&myRing, &data[0]));
+   cr_assert(NO_PLACE == RingWriteElements(&myRing, &testValues[0], 9));
+}
+
+Test(overwrite_tests, peek_lapped)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[4];
+   uint8_t testValues[4] = {1,2,3,4};
+   RingSpan_t spans[2];
+   uint32_t overwritten;
+
+   RingInitPow2(&myRing, &arr[0], 4, sizeof(uint8_t));
+   RingSetOverwrite(&myRing, 1);
+   RingWriteElements(&myRing, &testValues[0], 4);
+   overwritten = RingGetOverwriteCnt(&myRing);
+   cr_assert(OK == RingReadPeek(&myRing, &spans[0], 2));
+   RingWriteElements(&myRing, &testValues[0], 1);
+   cr_assert(overwritten != RingGetOverwriteCnt(&myRing));
+   cr_assert(OK == RingReadPeek(&myRing, &spans[0], 2));
+   cr_assert(2 == *(uint8_t*)spans[0].data);
+   cr_assert(OK == RingReadConsume(&myRing, 2));
+   cr_assert(2 == RingGetDataCnt(&myRing));
+}
+
+#define OVERWRITE_TEST_COUNT 200000
+
+static void* overwrite_producer(void* arg){
+   RingBuffer_t* ring = arg;
+   for(uint32_t i = 0; i < OVERWRITE_TEST_COUNT; i++){
+      RingWriteElement(ring, &i);
+   }
+   return NULL;
+}
+
+Test(overwrite_tests, lapped_reader)
+{
+   RingBuffer_t myRing;
+   uint32_t arr[16];
+   uint32_t data, last = 0, read = 0;
+   pthread_t producer;
+
+   RingInitPow2(&myRing, &arr[0], 16, sizeof(uint32_t));
+   RingSetOverwrite(&myRing, 1);
+   pthread_create(&producer, NULL, overwrite_producer, &myRing);
+   while(last + 1 < OVERWRITE_TEST_COUNT){
+      if(OK == RingReadElement(&myRing, &data)){
+         // Values are always increasing, gaps are dropped elements
+         cr_assert(read == 0 || data > last, "Excepted more than %u, got %u", last, data);
+         last = data;
+         read++;
+      }
+   }
+   pthread_join(producer, NULL);
+   cr_assert(OVERWRITE_TEST_COUNT == read + RingGetOverwriteCnt(&myRing) + RingGetDataCnt(&myRing));
+}
+
+Test(overwrite_tests, lapped_transfer)
+{
+   RingBuffer_t src, dst;
+   uint32_t arr[16];
+   uint32_t data[16], last = 0, read = 0;
+   size_t transferred;
+   pthread_t producer;
+
+   RingInitPow2(&src, &arr[0], 16, sizeof(uint32_t));
+   RingInitAlloc(&dst, 17, sizeof(uint32_t));
+   RingSetOverwrite(&src, 1);
+   pthread_create(&producer, NULL, overwrite_producer, &src);
+   while(last + 1 < OVERWRITE_TEST_COUNT){
+      if(OK != RingTransfer(&dst, &src, 16, &transferred)) continue;
+      cr_assert(OK == RingReadElements(&dst, &data[0], transferred));
+      for(size_t i = 0; i < transferred; i++){
+         // Elements of one transfer are consecutive, so they are not torn
+         cr_assert(read == 0 || data[i] > last, "Excepted more than %u, got %u", last, data[i]);
+         cr_assert(i == 0 || data[i] == last + 1, "Excepted %u, got %u", last + 1, data[i]);
+         last = data[i];
+         read++;
+      }
+   }
+   pthread_join(producer, NULL);
+   RingFree(&dst);
+}
+
+#define OVERWRITE_LINE_COUNT 100000
+
+static int overwriteLinesDone;
+
+static void* overwrite_line_producer(void* arg){
+   RingBuffer_t* ring = arg;
+   char line[9];
+   for(uint32_t i = 0; i < OVERWRITE_LINE_COUNT; i++){
+      snprintf(line, sizeof(line), "%07u\n", i);
+      RingWriteElements(ring, &line[0], 8);
+   }
+   __atomic_store_n(&overwriteLinesDone, 1, __ATOMIC_RELEASE);
+   return NULL;
+}
+
+Test(overwrite_tests, lapped_read_until)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[64];
+   char line[64];
+   size_t len;
+   uint32_t last = 0, read = 0;
+   pthread_t producer;
+
+   RingInitPow2(&myRing, &arr[0], 64, sizeof(uint8_t));
+   RingSetOverwrite(&myRing, 1);
+   cr_assert(NO_DATA == RingWriteRecord(&myRing, "abc", 3));
+   cr_assert(NO_DATA == RingReadRecord(&myRing, &line[0], sizeof(line), &len));
+   overwriteLinesDone = 0;
+   pthread_create(&producer, NULL, overwrite_line_producer, &myRing);
+   for(;;){
+      int done = __atomic_load_n(&overwriteLinesDone, __ATOMIC_ACQUIRE);
+      RingStatus_t retval = RingReadUntil(&myRing, "\n", 1, &line[0], sizeof(line), &len);
+      if(OK == retval && 8 == len){
+         // Whole lines are never read twice nor torn
+         uint32_t value = strtoul(&line[0], NULL, 10);
+         cr_assert(read == 0 || value > last, "Excepted more than %u, got %u", last, value);
+         last = value;
+         read++;
+      }else if(OK == retval){
+         // Reader lapped in the middle of a line gets its rest
+         cr_assert(len < 8 && '\n' == line[len - 1]);
+      }else if(done){
+         break;
+      }
+   }
+   pthread_join(producer, NULL);
+   cr_assert(OVERWRITE_LINE_COUNT - 1 == last);
+}
+
+Test(record_tests, write_read)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[32];
+   uint8_t testValues[10] = {1,2,3,4,5,6,7,8,9,10};
+   uint8_t data[10];
+   size_t len;
+
+   RingInitPow2(&myRing, &arr[0], 32, sizeof(uint8_t));
+   cr_assert(NO_DATA == RingReadRecord(&myRing, &data[0], 10, &len));
+   cr_assert(OK == RingWriteRecord(&myRing, &testValues[0], 10));
+   cr_assert(OK == RingWriteRecord(&myRing, &testValues[0], 3));
+   cr_assert(21 == RingGetDataCnt(&myRing));
+   cr_assert(NO_PLACE == RingReadRecord(&myRing, &data[0], 5, &len));
+   cr_assert(10 == len);
+   cr_assert(OK == RingReadRecord(&myRing, &data[0], 10, &len));
+   cr_assert(10 == len);
+   cr_assert_arr_eq(&testValues[0], &data[0], 10);
+   cr_assert(OK == RingReadRecord(&myRing, &data[0], 10, &len));
+   cr_assert(3 == len);
+   cr_assert_arr_eq(&testValues[0], &data[0], 3);
+   cr_assert(0 == RingGetDataCnt(&myRing));
+}
+
+Test(record_tests, padding_at_wrap)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[32];
+   uint8_t testValues[10] = {1,2,3,4,5,6,7,8,9,10};
+   void* record;
+   size_t len;
+
+   RingInitPow2(&myRing, &arr[0], 32, sizeof(uint8_t));
+   // Padding marker fits before array end
+   myRing.writePtr = 24;
+   myRing.readPtr = 24;
+   cr_assert(OK == RingWriteRecord(&myRing, &testValues[0], 10));
+   cr_assert(22 == RingGetDataCnt(&myRing));
+   cr_assert(OK == RingPeekRecord(&myRing, &record, &len));
+   cr_assert(10 == len);
+   cr_assert(&arr[4] == record);
+   cr_assert_arr_eq(&testValues[0], record, 10);
+   cr_assert(OK == RingConsumeRecord(&myRing));
+   cr_assert(0 == RingGetDataCnt(&myRing));
+
+   // Less than header left before array end
+   myRing.writePtr = 62;
+   myRing.readPtr = 62;
+   cr_assert(OK == RingWriteRecord(&myRing, &testValues[0], 4));
+   cr_assert(OK == RingPeekRecord(&myRing, &record, &len));
+   cr_assert(4 == len);
+   cr_assert(&arr[4] == record);
+   cr_assert(OK == RingConsumeRecord(&myRing));
+   cr_assert(NO_DATA == RingConsumeRecord(&myRing));
+
+   cr_assert(NO_PLACE == RingWriteRecord(&myRing, &testValues[0], 29));
+}
+
+Test(record_tests, mirrored_no_padding)
+{
+   RingBuffer_t myRing;
+   uint8_t testValues[100];
+   void* record;
+   size_t len;
+   for(uint32_t i = 0; i < sizeof(testValues); i++) testValues[i] = i;
+
+   cr_assert(OK == RingInitMirrored(&myRing, 4096, sizeof(uint8_t)));
+   myRing.writePtr = 4050;
+   myRing.readPtr = 4050;
+   cr_assert(OK == RingWriteRecord(&myRing, &testValues[0], 100));
+   cr_assert(104 == RingGetDataCnt(&myRing));
+   cr_assert(OK == RingPeekRecord(&myRing, &record, &len));
+   cr_assert(100 == len);
+   cr_assert_arr_eq(&testValues[0], record, 100);
+   RingFree(&myRing);
+}
+
+Test(stats_tests, counters)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[8];
+   uint8_t testValues[6] = {1,2,3,4,5,6};
+   uint8_t data[6];
+   RingStats_t stats;
+
+   RingInitPow2(&myRing, &arr[0], 8, sizeof(uint8_t));
+   RingWriteElements(&myRing, &testValues[0], 6);
+   RingReadElements(&myRing, &data[0], 4);
+   RingWriteElements(&myRing, &testValues[0], 5);
+   cr_assert(NO_PLACE == RingWriteElements(&myRing, &testValues[0], 2));
+   RingReadElements(&myRing, &data[0], 6);
+   RingReadElements(&myRing, &data[0], 1);
+   cr_assert(NO_DATA == RingReadElement(&myRing, &data[0]));
+#ifdef RING_STATS
+   cr_assert(OK == RingGetStats(&myRing, &stats));
+   cr_assert(7 == stats.highWater);
+   cr_assert(1 == stats.noPlace);
+   cr_assert(1 == stats.noData);
+   cr_assert(1 == stats.wrapWrites);
+   cr_assert(1 == stats.wrapReads);
+   cr_assert(11 == stats.bytesIn);
+   cr_assert(11 == stats.bytesOut);
+   cr_assert(OK == RingResetStats(&myRing));
+   RingGetStats(&myRing, &stats);
+   cr_assert(0 == stats.highWater && 0 == stats.noPlace && 0 == stats.bytesIn);
+#else
+   cr_assert(NO_DATA == RingGetStats(&myRing, &stats));
+   cr_assert(0 == stats.highWater && 0 == stats.bytesIn);
+#endif
+}
+
+Test(dwell_tests, histogram)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[64];
+   uint8_t testValues[16] = {0};
+   uint8_t data[16];
+   size_t len;
+   RingDwell_t dwell;
+
+   RingInitPow2(&myRing, &arr[0], 64, sizeof(uint8_t));
+#ifdef RING_DWELL
+   cr_assert(OK == RingEnableDwell(&myRing));
+   cr_assert(NO_DATA == RingSetOverwrite(&myRing, 1));
+   RingWriteElements(&myRing, &testValues[0], 10);
+   usleep(2000);
+   cr_assert(OK == RingGetDwell(&myRing, &dwell));
+   cr_assert(0 == dwell.count);
+   cr_assert(dwell.oldestAge >= 2000000);
+   RingReadElements(&myRing, &data[0], 4);
+   RingWriteElements(&myRing, &testValues[0], 10);
+   RingReadElements(&myRing, &data[0], 16);
+   cr_assert(OK == RingGetDwell(&myRing, &dwell));
+   cr_assert(20 == dwell.count);
+   cr_assert(0 == dwell.oldestAge);
+   cr_assert(dwell.max >= 2000000);
+   /* Half of elements waited through sleep, median is the other half. */
+   cr_assert(dwell.p50 < 2000000 && dwell.p99 == dwell.max && dwell.p999 == dwell.max);
+
+   /* Record is counted once. */
+   cr_assert(OK == RingResetDwell(&myRing));
+   RingWriteRecord(&myRing, &testValues[0], 10);
+   cr_assert(OK == RingReadRecord(&myRing, &data[0], sizeof(data), &len));
+   RingGetDwell(&myRing, &dwell);
+   cr_assert(1 == dwell.count);
+#else
+   cr_assert(NO_DATA == RingEnableDwell(&myRing));
+   cr_assert(NO_DATA == RingGetDwell(&myRing, &dwell));
+   cr_assert(0 == dwell.count);
+   (void)testValues;
+   (void)data;
+   (void)len;
+#endif
+   RingFree(&myRing);
+}
+
+Test(find_tests, pattern_at_wrap)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[64];
+   uint8_t testValues[60];
+   size_t offset;
+
+   memset(&testValues[0], 'a', sizeof(testValues));
+   RingInitPow2(&myRing, &arr[0], 64, sizeof(uint8_t));
+   RingWriteElements(&myRing, &testValues[0], 50);
+   RingReadConsume(&myRing, 50);
+   testValues[39] = '\r';
+   cr_assert(NO_DATA == RingFind(&myRing, "\r\n", 2, &offset));
+   RingWriteElements(&myRing, &testValues[0], 40);
+   cr_assert(NO_DATA == RingFind(&myRing, "\r\n", 2, &offset));
+   cr_assert(39 == myRing.findScanned);
+   RingWriteElements(&myRing, "\nab\r\n", 6);
+   cr_assert(OK == RingFind(&myRing, "\r\n", 2, &offset));
+   cr_assert(39 == offset);
+   cr_assert(OK == RingFind(&myRing, "a\r\n", 3, &offset));
+   cr_assert(38 == offset);
+   RingReadConsume(&myRing, 41);
+   cr_assert(0 == myRing.findScanned);
+   cr_assert(OK == RingFind(&myRing, "\r\n", 2, &offset));
+   cr_assert(2 == offset);
+}
+
+Test(find_tests, read_until)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[16];
+   uint8_t data[16];
+   size_t len;
+
+   RingInit(&myRing, &arr[0], 16, sizeof(uint8_t));
+   RingWriteElements(&myRing, "abc\nlonger line", 15);
+   cr_assert(OK == RingReadUntil(&myRing, "\n", 1, &data[0], sizeof(data), &len));
+   cr_assert(4 == len);
+   cr_assert_arr_eq("abc\n", &data[0], 4);
+   cr_assert(NO_DATA == RingReadUntil(&myRing, "\n", 1, &data[0], sizeof(data), &len));
+   RingWriteElements(&myRing, "\n", 1);
+   cr_assert(NO_PLACE == RingReadUntil(&myRing, "\n", 1, &data[0], 8, &len));
+   cr_assert(12 == len);
+   cr_assert(OK == RingReadUntil(&myRing, "\n", 1, &data[0], sizeof(data), &len));
+   cr_assert_arr_eq("longer line\n", &data[0], 12);
+   cr_assert(0 == RingGetDataCnt(&myRing));
+}
+
+#define SHARED_TEST_COUNT 100000
+
+Test(shared_tests, attach_by_name)
+{
+   RingShared_t producer, consumer;
+   char name[32];
+   uint32_t testValues[3] = {1,2,3};
+   uint32_t data[3];
+
+   snprintf(name, sizeof(name), "/ring_test_%d", (int)getpid());
+   cr_assert(OK == RingCreateShared(&producer, name, 4, sizeof(uint32_t)));
+   cr_assert(IO_ERROR == RingCreateShared(&consumer, name, 4, sizeof(uint32_t)));
+   cr_assert(OK == RingAttachShared(&consumer, name));
+   shm_unlink(name);
+   // Same region, mapped at other address
+   cr_assert(producer.buffer != consumer.buffer);
+   cr_assert(OK == RingSharedWriteElements(&producer, &testValues[0], 3));
+   cr_assert(OK == RingSharedWriteElements(&producer, &testValues[0], 1));
+   cr_assert(NO_PLACE == RingSharedWriteElement(&producer, &testValues[0]));
+   cr_assert(4 == RingSharedGetDataCnt(&consumer));
+   cr_assert(OK == RingSharedReadElements(&consumer, &data[0], 2));
+   cr_assert(OK == RingSharedWriteElements(&producer, &testValues[1], 2));
+   cr_assert(OK == RingSharedReadElements(&consumer, &data[0], 3));
+   cr_assert(3 == data[0] && 1 == data[1] && 2 == data[2]);
+   RingCloseShared(&producer);
+   RingCloseShared(&consumer);
+}
+
+Test(shared_tests, other_process)
+{
+   RingShared_t ring;
+   uint32_t data, expected = 0;
+   int status;
+
+   cr_assert(OK == RingCreateShared(&ring, NULL, 64, sizeof(uint32_t)));
+   pid_t pid = fork();
+   if(0 == pid){
+      RingShared_t producer;
+      if(OK != RingAttachSharedFd(&producer, ring.fd)) _exit(1);
+      for(uint32_t i = 0; i < SHARED_TEST_COUNT; i++){
+         while(OK != RingSharedWriteElement(&producer, &i)) sched_yield();
+      }
+      _exit(0);
+   }
+   while(expected < SHARED_TEST_COUNT){
+      if(OK == RingSharedReadElement(&ring, &data)){
+         cr_assert(expected == data, "Excepted %u, got %u", expected, data);
+         expected++;
+      }else{
+         sched_yield();
+      }
+   }
+   waitpid(pid, &status, 0);
+   cr_assert(WIFEXITED(status) && 0 == WEXITSTATUS(status));
+   RingCloseShared(&ring);
+}
+
+Test(shared_tests, invalid_region)
+{
+   RingShared_t ring, other;
+
+   cr_assert(NO_DATA == RingCreateShared(&ring, NULL, 6, sizeof(uint32_t)));
+   cr_assert(OK == RingCreateShared(&ring, NULL, 8, sizeof(uint32_t)));
+   ring.header -> version = RING_SHARED_VERSION + 1;
+   cr_assert(NO_DATA == RingAttachSharedFd(&other, ring.fd));
+   ring.header -> version = RING_SHARED_VERSION;
+   ring.header -> size = 1024;
+   cr_assert(NO_DATA == RingAttachSharedFd(&other, ring.fd));
+   RingCloseShared(&ring);
+}
+
+Test(persistent_tests, recover_after_sync)
+{
+   RingShared_t ring;
+   char path[64];
+   uint32_t testValues[6] = {1,2,3,4,5,6};
+   uint32_t data[6];
+
+   snprintf(path, sizeof(path), "/tmp/ring_test_%d.journal", (int)getpid());
+   unlink(path);
+   cr_assert(OK == RingOpenPersistent(&ring, path, 4, sizeof(uint32_t)));
+   cr_assert(OK == RingSharedWriteElements(&ring, &testValues[0], 3));
+   cr_assert(OK == RingSync(&ring));
+   cr_assert(OK == RingSharedWriteElements(&ring, &testValues[3], 1));
+   cr_assert(OK == RingSharedReadElements(&ring, &data[0], 2));
+   // Place freed after the last sync is not reused yet
+   cr_assert(0 == RingSharedGetSpace(&ring));
+   cr_assert(NO_PLACE == RingSharedWriteElement(&ring, &testValues[4]));
+   // Crash: nothing after the last sync is kept
+   RingCloseShared(&ring);
+   cr_assert(NO_DATA == RingOpenPersistent(&ring, path, 8, sizeof(uint32_t)));
+   cr_assert(OK == RingOpenPersistent(&ring, path, 4, sizeof(uint32_t)));
+   cr_assert(3 == RingSharedGetDataCnt(&ring));
+   cr_assert(OK == RingSharedReadElements(&ring, &data[0], 2));
+   cr_assert(1 == data[0] && 2 == data[1]);
+   cr_assert(OK == RingSync(&ring));
+   cr_assert(OK == RingSharedWriteElements(&ring, &testValues[3], 3));
+   cr_assert(OK == RingSyncPeriodic(&ring, 0));
+   RingCloseShared(&ring);
+   cr_assert(OK == RingOpenPersistent(&ring, path, 4, sizeof(uint32_t)));
+   cr_assert(OK == RingSharedReadElements(&ring, &data[0], 4));
+   cr_assert(3 == data[0] && 4 == data[1] && 5 == data[2] && 6 == data[3]);
+   RingCloseShared(&ring);
+   unlink(path);
+}
+
+Test(persistent_tests, torn_checkpoint)
+{
+   RingShared_t ring;
+   char path[64];
+   uint32_t testValues[2] = {1,2};
+   uint32_t data;
+
+   snprintf(path, sizeof(path), "/tmp/ring_test_torn_%d.journal", (int)getpid());
+   unlink(path);
+   cr_assert(OK == RingOpenPersistent(&ring, path, 4, sizeof(uint32_t)));
+   RingSharedWriteElements(&ring, &testValues[0], 1);
+   RingSync(&ring);
+   RingSharedWriteElements(&ring, &testValues[1], 1);
+   RingSync(&ring);
+   // Newest checkpoint damaged, older one is used
+   ring.header -> checkpoints[(ring.syncSeq) & 1].writePtr ^= 0x100;
+   RingCloseShared(&ring);
+   cr_assert(OK == RingOpenPersistent(&ring, path, 4, sizeof(uint32_t)));
+   cr_assert(1 == RingSharedGetDataCnt(&ring));
+   cr_assert(OK == RingSharedReadElement(&ring, &data));
+   cr_assert(1 == data);
+   RingCloseShared(&ring);
+   unlink(path);
+}
+
+Test(alloc_tests, options)
+{
+   RingBuffer_t myRing;
+   RingAllocOptions_t options = RING_ALLOC_OPTIONS_INIT;
+   uint32_t testValues[3] = {1,2,3};
+   uint32_t data[3];
+   RingStatus_t ret;
+
+   options.alignment = RING_CACHE_LINE;
+   cr_assert(OK == RingInitAllocEx(&myRing, 100, sizeof(uint32_t), &options));
+   cr_assert(0 == (uintptr_t)myRing.buffer % RING_CACHE_LINE);
+   cr_assert(99 == RingGetSpace(&myRing));
+   cr_assert(OK == RingFree(&myRing));
+
+   options.alignment = 3;
+   cr_assert(NO_DATA == RingInitAllocEx(&myRing, 100, sizeof(uint32_t), &options));
+   options.alignment = 0;
+   options.pow2 = 1;
+   cr_assert(NO_DATA == RingInitAllocEx(&myRing, 100, sizeof(uint32_t), &options));
+
+   // Mapped memory is not cleared again, but it is zeroed
+   options.hugePages = RING_HUGE_TRANSPARENT;
+   options.prefault = 1;
+   cr_assert(OK == RingInitAllocEx(&myRing, 1 << 20, sizeof(uint32_t), &options));
+   cr_assert(0 == (uintptr_t)myRing.buffer % RING_HUGE_PAGE_SIZE);
+   cr_assert(0 == ((uint32_t*)myRing.buffer)[12345]);
+   cr_assert((1 << 20) == RingGetSpace(&myRing));
+   cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 3));
+   cr_assert(OK == RingReadElements(&myRing, &data[0], 3));
+   cr_assert_arr_eq(&testValues[0], &data[0], sizeof(data));
+   cr_assert(OK == RingFree(&myRing));
+
+   options.hugePages = RING_HUGE_NONE;
+   options.prefault = 0;
+   options.numaNode = 0;
+   ret = RingInitAllocEx(&myRing, 4096, sizeof(uint32_t), &options);
+   // Kernels without NUMA support refuse mbind
+   if(NO_PTR != ret){
+      cr_assert(OK == ret);
+      cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 3));
+      cr_assert(OK == RingFree(&myRing));
+   }
+}
+
+Test(elastic_tests, grow_shrink)
+{
+   RingBuffer_t myRing;
+   RingAllocOptions_t options = RING_ALLOC_OPTIONS_INIT;
+   uint8_t arr[8];
+   uint16_t data[64];
+   uint16_t value = 0, expected = 0;
+
+   RingInit(&myRing, &arr[0], 8, sizeof(uint8_t));
+   cr_assert(NO_DATA == RingSetElastic(&myRing, 8, 64));
+
+   RingInitAlloc(&myRing, 8, sizeof(uint16_t));
+   cr_assert(NO_DATA == RingSetElastic(&myRing, 16, 64));
+   cr_assert(OK == RingSetElastic(&myRing, 4, 64));
+   // Data wraps around array end before buffer has to grow
+   for(int i = 0; i < 5; i++){
+      RingWriteElement(&myRing, &value);
+      value++;
+   }
+   RingReadElements(&myRing, &data[0], 5);
+   expected = 5;
+   for(int i = 0; i < 63; i++){
+      cr_assert(OK == RingWriteElement(&myRing, &value));
+      value++;
+   }
+   cr_assert(64 == RingGetElementsCapacity(&myRing));
+   cr_assert(NO_PLACE == RingWriteElement(&myRing, &value));
+   cr_assert(OK == RingReadElements(&myRing, &data[0], 63));
+   for(int i = 0; i < 63; i++){
+      cr_assert(expected++ == data[i]);
+   }
+
+   // Low occupancy for a whole buffer size of reads halves buffer
+   cr_assert(64 == RingGetElementsCapacity(&myRing));
+   RingWriteElement(&myRing, &value);
+   value++;
+   RingReadElement(&myRing, &data[0]);
+   cr_assert(expected++ == data[0]);
+   cr_assert(32 == RingGetElementsCapacity(&myRing));
+   for(int i = 0; i < 200; i++){
+      RingWriteElement(&myRing, &value);
+      value++;
+      RingReadElement(&myRing, &data[0]);
+      cr_assert(expected++ == data[0]);
+   }
+   cr_assert(4 == RingGetElementsCapacity(&myRing));
+   RingFree(&myRing);
+
+   options.pow2 = 1;
+   RingInitAllocEx(&myRing, 4, sizeof(uint16_t), &options);
+   cr_assert(NO_DATA == RingSetElastic(&myRing, 4, 48));
+   cr_assert(OK == RingSetElastic(&myRing, 4, 16));
+   cr_assert(NO_DATA == RingSetOverwrite(&myRing, 1));
+   cr_assert(OK == RingWriteElements(&myRing, &data[0], 9));
+   cr_assert(16 == RingGetElementsCapacity(&myRing));
+   cr_assert(7 == RingGetSpace(&myRing));
+   RingFree(&myRing);
+
+   // Resizing would drop alignment of the original allocation
+   options.alignment = 64;
+   cr_assert(OK == RingInitAllocEx(&myRing, 4, sizeof(uint16_t), &options));
+   cr_assert(NO_DATA == RingSetElastic(&myRing, 4, 16));
+   RingFree(&myRing);
+}
+
+Test(elastic_tests, fd_grow_shrink)
+{
+   RingBuffer_t myRing;
+   uint8_t testValues[40];
+   uint8_t data[40];
+   size_t transferred;
+   int fds[2];
+
+   for(int i = 0; i < 40; i++) testValues[i] = i;
+   cr_assert(0 == pipe(fds));
+   RingInitAlloc(&myRing, 8, sizeof(uint8_t));
+   cr_assert(OK == RingSetElastic(&myRing, 8, 64));
+
+   // Read from descriptor grows buffer instead of taking only free space
+   cr_assert(40 == write(fds[1], &testValues[0], 40));
+   cr_assert(OK == RingWriteFromFd(&myRing, fds[0], 100, &transferred));
+   cr_assert(40 == transferred);
+   cr_assert(64 == RingGetElementsCapacity(&myRing));
+
+   // Buffer drained only through descriptor shrinks back
+   cr_assert(OK == RingReadToFd(&myRing, fds[1], 100, &transferred));
+   cr_assert(40 == transferred);
+   cr_assert(40 == read(fds[0], &data[0], 40));
+   cr_assert_arr_eq(&testValues[0], &data[0], 40);
+   for(int i = 0; i < 100; i++){
+      cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 4));
+      cr_assert(OK == RingReadToFd(&myRing, fds[1], 100, &transferred));
+      cr_assert(4 == transferred);
+      cr_assert(4 == read(fds[0], &data[0], 4));
+   }
+   cr_assert(8 == RingGetElementsCapacity(&myRing));
+
+   // Delimited reads shrink it too
+   cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 40));
+   cr_assert(64 == RingGetElementsCapacity(&myRing));
+   cr_assert(OK == RingReadElements(&myRing, &data[0], 40));
+   for(int i = 0; i < 100; i++){
+      cr_assert(OK == RingWriteElements(&myRing, &testValues[0], 4));
+      cr_assert(OK == RingReadUntil(&myRing, &testValues[3], 1, &data[0], 40, &transferred));
+      cr_assert(4 == transferred);
+   }
+   cr_assert(8 == RingGetElementsCapacity(&myRing));
+   RingFree(&myRing);
+   close(fds[0]);
+   close(fds[1]);
+}
+
+Test(arena_tests, alloc_release)
+{
+   RingArena_t arena;
+   RingCompact_t* rings[1000];
+   uint32_t testValues[6] = {1,2,3,4,5,6};
+   uint32_t data[6];
+
+   cr_assert(NO_DATA == RingArenaInit(&arena, 1000, 12, sizeof(uint32_t)));
+   cr_assert(NO_PTR == RingArenaInit(&arena, 1000, (size_t)1 << 30, SIZE_MAX / 4));
+   cr_assert(NO_PTR == RingArenaInit(&arena, 1u << 31, (size_t)1 << 30, 1u << 20));
+   cr_assert(OK == RingArenaInit(&arena, 1000, 8, sizeof(uint32_t)));
+   cr_assert(16 == sizeof(RingCompact_t));
+   for(int i = 0; i < 1000; i++){
+      rings[i] = RingArenaAlloc(&arena);
+      cr_assert(NULL != rings[i]);
+      cr_assert(8 == RingCompactGetSpace(rings[i]));
+   }
+   cr_assert(NULL == RingArenaAlloc(&arena));
+
+   // Adjacent buffers do not share data
+   for(int i = 0; i < 1000; i++){
+      cr_assert(OK == RingCompactWriteElements(&arena, rings[i], &testValues[0], 6));
+      cr_assert(OK == RingCompactReadElements(&arena, rings[i], &data[0], 4));
+      cr_assert(OK == RingCompactWriteElements(&arena, rings[i], &testValues[0], 6));
+      cr_assert(NO_PLACE == RingCompactWriteElements(&arena, rings[i], &testValues[0], 1));
+   }
+   for(int i = 0; i < 1000; i++){
+      cr_assert(OK == RingCompactReadElements(&arena, rings[i], &data[0], 2));
+      cr_assert_arr_eq(&testValues[4], &data[0], 2 * sizeof(uint32_t));
+      cr_assert(OK == RingCompactReadElements(&arena, rings[i], &data[0], 6));
+      cr_assert_arr_eq(&testValues[0], &data[0], sizeof(testValues));
+      cr_assert(NO_DATA == RingCompactReadElements(&arena, rings[i], &data[0], 1));
+   }
+
+   cr_assert(OK == RingArenaRelease(&arena, rings[500]));
+   cr_assert(NO_DATA == RingArenaRelease(&arena, rings[500]));
+   cr_assert(999 == arena.used);
+   RingCompactWriteElements(&arena, rings[501], &testValues[0], 3);
+   cr_assert(rings[500] == RingArenaAlloc(&arena));
+   cr_assert(0 == RingCompactGetDataCnt(rings[500]));
+   cr_assert(3 == RingCompactGetDataCnt(rings[501]));
+   cr_assert(OK == RingArenaFree(&arena));
+}
+
+Test(copy_tests, streaming)
+{
+   RingBuffer_t myRing;
+   static uint8_t in[70000], out[70000];
+
+   for(size_t i = 0; i < sizeof(in); i++){
+      in[i] = (uint8_t)(i * 7 + i / 251);
+   }
+   RingInitAlloc(&myRing, 65536 + 3, sizeof(uint8_t));
+   cr_assert(OK == RingSetCopyThreshold(&myRing, 1));
+   // Lengths and offsets not multiple of vector size, data wraps
+   for(size_t len = 1; len < 65536; len = len * 3 + 5){
+      memset(out, 0, sizeof(out));
+      cr_assert(OK == RingWriteElements(&myRing, &in[len % 61], len));
+      cr_assert(OK == RingReadElements(&myRing, &out[len % 37], len));
+      cr_assert(0 == memcmp(&in[len % 61], &out[len % 37], len), "Mismatch for length %zu", len);
+   }
+   RingFree(&myRing);
+}
+
+static int fd_readable(int fd){
+   struct pollfd pfd = { fd, POLLIN, 0 };
+   uint64_t value;
+   if(1 != poll(&pfd, 1, 0)) return 0;
+   // Resets eventfd
+   return sizeof(value) == read(fd, &value, sizeof(value));
+}
+
+Test(eventfd_tests, transitions)
+{
+   RingBuffer_t myRing;
+   uint8_t arr[8];
+   uint8_t testValues[8] = {1,2,3,4,5,6,7,8};
+   uint8_t data[8];
+
+   RingInit(&myRing, &arr[0], 8, sizeof(uint8_t));
+   cr_assert(NO_DATA == RingEnableEventFd(&myRing, 4));
+   cr_assert(-1 == RingGetReadFd(&myRing));
+   RingInitPow2(&myRing, &arr[0], 8, sizeof(uint8_t));
+   cr_assert(NO_DATA == RingEnableEventFd(&myRing, 9));
+   cr_assert(OK == RingEnableEventFd(&myRing, 4));
+   int readFd = RingGetReadFd(&myRing);
+   int writeFd = RingGetWriteFd(&myRing);
+
+   cr_assert(!fd_readable(readFd));
+   RingWriteElement(&myRing, &testValues[0]);
+   cr_assert(fd_readable(readFd));
+   // Writes to non-empty buffer are coalesced
+   RingWriteElements(&myRing, &testValues[1], 2);
+   cr_assert(!fd_readable(readFd));
+   RingReadElements(&myRing, &data[0], 3);
+   RingWriteElements(&myRing, &testValues[0], 8);
+   cr_assert(fd_readable(readFd));
+
+   // Writer is signalled only after NO_PLACE and below low water
+   cr_assert(NO_PLACE == RingWriteElement(&myRing, &testValues[0]));
+   RingReadElements(&myRing, &data[0], 4);
+   cr_assert(!fd_readable(writeFd));
+   RingReadElement(&myRing, &data[0]);
+   cr_assert(fd_readable(writeFd));
+   RingReadElement(&myRing, &data[0]);
+   cr_assert(!fd_readable(writeFd));
+   RingFree(&myRing);
+}
+
+#define EVENTFD_TEST_COUNT 100000
+
+static void* eventfd_producer(void* arg){
+   RingBuffer_t* ring = arg;
+   struct pollfd pfd = { RingGetWriteFd(ring), POLLIN, 0 };
+
+   for(uint32_t i = 0; i < EVENTFD_TEST_COUNT; i++){
+      while(OK != RingWriteElement(ring, &i)){
+         poll(&pfd, 1, -1);
+         fd_readable(pfd.fd);
+      }
+   }
+   return NULL;
+}
+
+Test(eventfd_tests, two_threads)
+{
+   RingBuffer_t myRing;
+   uint32_t arr[64];
+   uint32_t data;
+   pthread_t producer;
+
+   RingInitPow2(&myRing, &arr[0], 64, sizeof(uint32_t));
+   RingEnableEventFd(&myRing, 32);
+   struct pollfd pfd = { RingGetReadFd(&myRing), POLLIN, 0 };
+   pthread_create(&producer, NULL, eventfd_producer, &myRing);
+   for(uint32_t i = 0; i < EVENTFD_TEST_COUNT; i++){
+      while(OK != RingReadElement(&myRing, &data)){
+         cr_assert(1 == poll(&pfd, 1, 10000));
+         fd_readable(pfd.fd);
+      }
+      cr_assert(i == data, "Excepted %u, got %u", i, data);
+   }
+   pthread_join(producer, NULL);
+   RingFree(&myRing);
+}
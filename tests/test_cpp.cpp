@@ -0,0 +1,181 @@
+#include <criterion/criterion.h>
+#include <criterion/logging.h>
+#include <criterion/assert.h>
+#include <ring.hpp>
+#include <ring_coro.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+Test(cpp_tests, capacity){
+   Ring<uint8_t, 10> myRing;
+   static_assert(10 == Ring<uint8_t, 10>::capacity(), "Constexpr capacity");
+   cr_assert(myRing.empty());
+   cr_assert(10 == myRing.space());
+}
+
+Test(cpp_tests, push_pop_overlap){
+   Ring<uint32_t, 4> myRing;
+   uint32_t data;
+
+   for(uint32_t i = 0; i < 3; i++) cr_assert(OK == myRing.push(i));
+   for(uint32_t i = 0; i < 3; i++) cr_assert(OK == myRing.pop(data));
+   for(uint32_t i = 0; i < 4; i++) cr_assert(OK == myRing.push(i + 10));
+   cr_assert(myRing.full());
+   cr_assert(NO_PLACE == myRing.push(1));
+   cr_assert(10 == *myRing.front());
+   cr_assert(13 == *myRing.back());
+   for(uint32_t i = 0; i < 4; i++){
+      cr_assert(OK == myRing.pop(data));
+      cr_assert(i + 10 == data);
+   }
+   cr_assert(NO_DATA == myRing.pop(data));
+   cr_assert(nullptr == myRing.front());
+}
+
+Test(cpp_tests, move_only){
+   Ring<std::unique_ptr<int>, 2> myRing;
+   std::unique_ptr<int> data;
+
+   cr_assert(OK == myRing.push(std::make_unique<int>(5)));
+   cr_assert(OK == myRing.emplace(new int(6)));
+   cr_assert(OK == myRing.pop(data));
+   cr_assert(5 == *data);
+   cr_assert(OK == myRing.pop(data));
+   cr_assert(6 == *data);
+}
+
+Test(cpp_tests, destroys_elements){
+   auto counter = std::make_shared<int>(0);
+   {
+      Ring<std::shared_ptr<int>, 8> myRing;
+      for(int i = 0; i < 5; i++) myRing.push(counter);
+      cr_assert(6 == counter.use_count());
+      cr_assert(OK == myRing.drop());
+      cr_assert(5 == counter.use_count());
+   }
+   cr_assert(1 == counter.use_count());
+}
+
+Test(cpp_tests, strings){
+   Ring<std::string, 3> myRing;
+   std::string data;
+
+   cr_assert(OK == myRing.emplace(40, 'x'));
+   cr_assert(OK == myRing.push(std::string("short")));
+   cr_assert(OK == myRing.pop(data));
+   cr_assert(std::string(40, 'x') == data);
+   cr_assert(OK == myRing.pop(data));
+   cr_assert("short" == data);
+}
+
+static RingTask coro_producer(RingAsync<uint32_t>& async, uint32_t count){
+   uint32_t chunk[3];
+   for(uint32_t i = 0; i < count; i += 3){
+      for(uint32_t j = 0; j < 3; j++) chunk[j] = i + j;
+      co_await async.write(chunk);
+   }
+}
+
+static RingTask coro_consumer(RingAsync<uint32_t>& async, uint32_t count, std::vector<uint32_t>& out){
+   uint32_t chunk[2];
+   for(uint32_t i = 0; i < count; i += 2){
+      if(OK != co_await async.read(chunk)) co_return;
+      out.insert(out.end(), chunk, chunk + 2);
+   }
+}
+
+Test(coro_tests, producer_consumer){
+   RingBuffer_t ring;
+   uint32_t arr[4];
+   RingExecutor executor;
+   std::vector<uint32_t> out;
+
+   RingInitPow2(&ring, &arr[0], 4, sizeof(uint32_t));
+   RingAsync<uint32_t> async(ring, executor);
+   // Consumer starts first and parks on empty buffer
+   executor.spawn(coro_consumer(async, 96, out));
+   executor.spawn(coro_producer(async, 96));
+   executor.run();
+   cr_assert(96 == out.size());
+   for(uint32_t i = 0; i < 96; i++) cr_assert(i == out[i]);
+   cr_assert(0 == RingGetDataCnt(&ring));
+}
+
+static RingTask coro_oversized(RingAsync<uint32_t>& async, RingStatus_t& status){
+   uint32_t data[5] = {0};
+   status = co_await async.read(data);
+}
+
+Test(coro_tests, oversized){
+   RingBuffer_t ring;
+   uint32_t arr[4];
+   RingExecutor executor;
+   RingStatus_t status = OK;
+
+   RingInitPow2(&ring, &arr[0], 4, sizeof(uint32_t));
+   RingAsync<uint32_t> async(ring, executor);
+   executor.spawn(coro_oversized(async, status));
+   cr_assert(1 == executor.run());
+   cr_assert(NO_DATA == status);
+}
+
+static RingTask coro_parked(RingAsync<uint32_t>& async, std::shared_ptr<int> token){
+   uint32_t data[2];
+   (void)token;
+   co_await async.read(data);
+}
+
+Test(coro_tests, destroys_parked){
+   RingBuffer_t ring;
+   uint32_t arr[4];
+   auto counter = std::make_shared<int>(0);
+
+   RingInitPow2(&ring, &arr[0], 4, sizeof(uint32_t));
+   {
+      RingExecutor executor;
+      {
+         RingAsync<uint32_t> async(ring, executor);
+         executor.spawn(coro_parked(async, counter));
+         cr_assert(1 == executor.run());
+         cr_assert(2 == counter.use_count());
+      }
+      // Frame parked on destroyed adapter is released with it
+      cr_assert(1 == counter.use_count());
+      RingAsync<uint32_t> async(ring, executor);
+      executor.spawn(coro_parked(async, counter));
+      cr_assert(2 == counter.use_count());
+   }
+   // Task spawned but never run is released by executor
+   cr_assert(1 == counter.use_count());
+}
+
+static RingTask coro_read_status(RingAsync<uint32_t>& async, std::span<uint32_t> data, RingStatus_t& status){
+   status = co_await async.read(data);
+}
+
+Test(coro_tests, propagates_errors){
+   RingBuffer_t ring;
+   uint32_t arr[4];
+   uint32_t out[2];
+   RingExecutor executor;
+   RingStatus_t first = OK, second = OK;
+
+   RingInitPow2(&ring, &arr[0], 4, sizeof(uint32_t));
+   RingAsync<uint32_t> async(ring, executor);
+   // Read to null place fails at once instead of parking
+   executor.spawn(coro_read_status(async, std::span<uint32_t>(), first));
+   cr_assert(1 == executor.run());
+   cr_assert(NO_PTR == first);
+
+   // Same failure of read parked behind another one is completed with it
+   executor.spawn(coro_read_status(async, out, first));
+   executor.spawn(coro_read_status(async, std::span<uint32_t>(), second));
+   cr_assert(2 == executor.run());
+   executor.spawn(coro_producer(async, 3));
+   executor.run();
+   cr_assert(OK == first);
+   cr_assert(0 == out[0] && 1 == out[1]);
+   cr_assert(NO_PTR == second);
+   cr_assert(1 == RingGetDataCnt(&ring));
+}